@@ -152,6 +152,60 @@ mz_ulong mz_crc32(mz_ulong crc, const mz_uint8 *ptr, size_t buf_len)
 }
 #endif
 
+static mz_uint32 mz_gf2_matrix_times(const mz_uint32 *mat, mz_uint32 vec)
+{
+    mz_uint32 sum = 0;
+    for (; vec; vec >>= 1, ++mat)
+        if (vec & 1)
+            sum ^= *mat;
+    return sum;
+}
+
+static void mz_gf2_matrix_square(mz_uint32 *square, const mz_uint32 *mat)
+{
+    int n;
+    for (n = 0; n < 32; ++n)
+        square[n] = mz_gf2_matrix_times(mat, mat[n]);
+}
+
+/* Same algorithm as crc32_combine() of zlib: Apply len2 zero bytes to crc1 by squaring the CRC-32 operator matrix. */
+mz_ulong mz_crc32_combine(mz_ulong crc1, mz_ulong crc2, size_t len2)
+{
+    int n;
+    mz_uint32 row, even[32], odd[32];
+    mz_uint32 crc = (mz_uint32)crc1;
+
+    if (len2 == 0)
+        return crc1;
+
+    /* Operator for one zero bit in odd. */
+    odd[0] = 0xEDB88320UL;
+    row = 1;
+    for (n = 1; n < 32; ++n) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    /* Operator for two zero bits in even, four zero bits in odd. */
+    mz_gf2_matrix_square(even, odd);
+    mz_gf2_matrix_square(odd, even);
+
+    /* Apply len2 zero bytes to crc1, the first square puts the operator for one zero byte (eight zero bits) in even. */
+    do {
+        mz_gf2_matrix_square(even, odd);
+        if (len2 & 1)
+            crc = mz_gf2_matrix_times(even, crc);
+        len2 >>= 1;
+        if (len2 == 0)
+            break;
+        mz_gf2_matrix_square(odd, even);
+        if (len2 & 1)
+            crc = mz_gf2_matrix_times(odd, crc);
+        len2 >>= 1;
+    } while (len2 != 0);
+
+    return crc ^ (mz_uint32)crc2;
+}
+
 void mz_free(void *p)
 {
     MZ_FREE(p);
@@ -6883,6 +6937,49 @@ mz_bool mz_zip_writer_add_staged_data(mz_zip_writer_staged_context *pContext, co
     return MZ_FALSE;
 }
 
+mz_bool mz_zip_writer_add_staged_compressed_data(mz_zip_writer_staged_context *pContext, const void *pComp_buf, size_t comp_size, mz_uint32 uncomp_crc32, mz_uint64 uncomp_size)
+{
+    size_t ofs = 0;
+
+    if (! pContext->pCompressor)
+        return MZ_FALSE;
+
+    if (pContext->file_ofs + uncomp_size > pContext->max_size)
+    {
+        mz_zip_set_error(pContext->pZip, MZ_ZIP_FILE_READ_FAILED);
+        pContext->pZip->m_pFree(pContext->pZip->m_pAlloc_opaque, pContext->pCompressor);
+        pContext->pCompressor = NULL;
+        return MZ_FALSE;
+    }
+
+    /* Align the output of the compressor to a byte boundary and reset its dictionary, so that the data compressed */
+    /* after pComp_buf will not reference the data compressed before pComp_buf. */
+    if (tdefl_compress_buffer(pContext->pCompressor, NULL, 0, TDEFL_FULL_FLUSH) != TDEFL_STATUS_OKAY)
+    {
+        mz_zip_set_error(pContext->pZip, MZ_ZIP_COMPRESSION_FAILED);
+        pContext->pZip->m_pFree(pContext->pZip->m_pAlloc_opaque, pContext->pCompressor);
+        pContext->pCompressor = NULL;
+        return MZ_FALSE;
+    }
+
+    while (ofs < comp_size)
+    {
+        int n = (int)MZ_MIN(comp_size - ofs, (size_t)0x40000000);
+        if (! mz_zip_writer_add_put_buf_callback((const mz_uint8 *)pComp_buf + ofs, n, &pContext->add_state))
+        {
+            mz_zip_set_error(pContext->pZip, MZ_ZIP_FILE_WRITE_FAILED);
+            pContext->pZip->m_pFree(pContext->pZip->m_pAlloc_opaque, pContext->pCompressor);
+            pContext->pCompressor = NULL;
+            return MZ_FALSE;
+        }
+        ofs += n;
+    }
+
+    pContext->file_ofs += uncomp_size;
+    pContext->uncomp_crc32 = (mz_uint32)mz_crc32_combine(pContext->uncomp_crc32, uncomp_crc32, (size_t)uncomp_size);
+    return MZ_TRUE;
+}
+
 mz_bool mz_zip_writer_add_staged_finish(mz_zip_writer_staged_context *pContext)
 {
     if (! mz_zip_writer_add_staged_data(pContext, NULL, 0) ||
@@ -59,6 +59,8 @@ namespace Slic3r::CLI
 
     bool    has_full_config_from_profiles(const Data& cli);
     bool    process_profiles_sharing(const Data& cli);
+    bool    has_time_estimate_action(const Data& cli);
+    bool    process_time_estimates(const Data& cli);
     bool    process_actions(Data& cli, const DynamicPrintConfig& print_config, std::vector<Model>& models);
 
     // Implemented in GuiParams.cpp
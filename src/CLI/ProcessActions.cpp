@@ -13,6 +13,9 @@
 #include <boost/nowide/iostream.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 
 #include "libslic3r/libslic3r.h"
 #if !SLIC3R_OPENGL_ES
@@ -35,6 +38,8 @@
 #include "libslic3r/PNGReadWrite.hpp"
 #include "libslic3r/MultipleBeds.hpp"
 #include "libslic3r/BuildVolume.hpp"
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+#include "libslic3r/Utils/JsonUtils.hpp"
 
 #include "CLI/CLI.hpp"
 #include "CLI/ProfilesSharingUtils.hpp"
@@ -44,6 +49,8 @@
 
 namespace Slic3r::CLI {
 
+namespace pt = boost::property_tree;
+
 static bool has_profile_sharing_action(const Data& cli)
 {
     return cli.actions_config.has("query-printer-models") || cli.actions_config.has("query-print-filament-profiles");
@@ -118,6 +125,122 @@ bool process_profiles_sharing(const Data& cli)
     return true;
 }
 
+bool has_time_estimate_action(const Data& cli)
+{
+    return cli.actions_config.has("estimate_time") && cli.actions_config.opt_bool("estimate_time");
+}
+
+// Input files and G-code files found recursively inside the input directories, sorted.
+static std::vector<std::string> gcode_files_to_estimate(const std::vector<std::string>& input_files)
+{
+    std::vector<std::string> out;
+    for (const std::string& input : input_files) {
+        if (boost::filesystem::is_directory(input)) {
+            for (const boost::filesystem::directory_entry& entry : boost::filesystem::recursive_directory_iterator(input))
+                if (boost::filesystem::is_regular_file(entry.status()) && is_gcode_file(entry.path().string()))
+                    out.emplace_back(entry.path().string());
+        } else
+            out.emplace_back(input);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+static std::string json_number(double value)
+{
+    // write_json_with_post_process() turns quoted plain decimal numbers into JSON numbers.
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.3f", std::max(0., value));
+    return buf;
+}
+
+static pt::ptree estimate_time(const std::string& file)
+{
+    pt::ptree node;
+    node.put("file", file);
+
+    GCodeProcessor processor;
+    processor.enable_statistics_only(true);
+    try {
+        processor.process_file(file);
+    } catch (const std::exception& ex) {
+        boost::nowide::cerr << "estimate-time error: " << file << ": " << ex.what() << std::endl;
+        node.put("error", ex.what());
+        return node;
+    }
+    const GCodeProcessorResult& result = processor.get_result();
+
+    pt::ptree modes_node;
+    for (const PrintEstimatedStatistics::ETimeMode mode : { PrintEstimatedStatistics::ETimeMode::Normal, PrintEstimatedStatistics::ETimeMode::Stealth }) {
+        const PrintEstimatedStatistics::Mode& data = result.print_statistics.modes[static_cast<size_t>(mode)];
+        if (data.time == 0.0f)
+            continue;
+        pt::ptree mode_node;
+        mode_node.put("time", json_number(data.time));
+        pt::ptree layers_node;
+        for (float layer_time : data.layers_times)
+            layers_node.push_back({ "", pt::ptree(json_number(layer_time)) });
+        mode_node.add_child("layers_times", layers_node);
+        modes_node.add_child(mode == PrintEstimatedStatistics::ETimeMode::Normal ? "normal" : "stealth", mode_node);
+    }
+    node.add_child("modes", modes_node);
+
+    pt::ptree extruders_node;
+    for (const auto& [extruder_id, volume] : result.print_statistics.volumes_per_extruder) {
+        const double diameter = extruder_id < result.filament_diameters.size() ? result.filament_diameters[extruder_id] : 0.;
+        const double density  = extruder_id < result.filament_densities.size() ? result.filament_densities[extruder_id] : 0.;
+        pt::ptree extruder_node;
+        extruder_node.put("extruder", extruder_id);
+        extruder_node.put("volume_mm3", json_number(volume));
+        extruder_node.put("length_mm", json_number(diameter > 0. ? volume / (0.25 * PI * sqr(diameter)) : 0.));
+        extruder_node.put("weight_g", json_number(volume * density * 0.001));
+        extruders_node.push_back({ "", extruder_node });
+    }
+    node.add_child("extruders", extruders_node);
+    return node;
+}
+
+bool process_time_estimates(const Data& cli)
+{
+    const std::vector<std::string> files = gcode_files_to_estimate(cli.input_files);
+    if (files.empty()) {
+        boost::nowide::cerr << "estimate-time error: No G-code files to estimate." << std::endl;
+        return false;
+    }
+
+    // Each file is processed by its own GCodeProcessor, the estimates are collected in the order of the files.
+    std::vector<pt::ptree> estimates(files.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, files.size(), 1), [&files, &estimates](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i)
+            estimates[i] = estimate_time(files[i]);
+    });
+
+    pt::ptree files_node;
+    for (pt::ptree& estimate : estimates)
+        files_node.push_back({ "", std::move(estimate) });
+    pt::ptree root;
+    root.add_child("files", files_node);
+    const std::string json = write_json_with_post_process(root);
+
+    if (cli.misc_config.has("output")) {
+        const std::string file = cli.misc_config.opt_string("output");
+        boost::nowide::ofstream c;
+        c.open(file, std::ios::out | std::ios::trunc);
+        c << json;
+        c.close();
+        if (c.fail()) {
+            boost::nowide::cerr << "estimate-time error: Failed to write " << file << std::endl;
+            return false;
+        }
+        boost::nowide::cout << "Time estimates of " << files.size() << " G-code files are written into " << file << std::endl;
+    }
+    else
+        boost::nowide::cout << json;
+
+    return true;
+}
+
 namespace IO {
     enum ExportFormat : int {
         OBJ,
@@ -9,6 +9,7 @@
 #include "libslic3r/Config.hpp"
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/Platform.hpp"
+#include "libslic3r/SliceCache.hpp"
 #include "libslic3r/Utils.hpp"
 #include "libslic3r/Thread.hpp"
 #include "libslic3r/BlacklistedLibraryCheck.hpp"
@@ -326,6 +327,11 @@ bool setup(Data& cli, int argc, char** argv)
 
     set_data_dir(cli.misc_config.has("datadir") ? cli.misc_config.opt_string("datadir") : get_default_datadir());
 
+    if (cli.misc_config.has("slice_cache"))
+        set_slice_cache_dir(cli.misc_config.opt_string("slice_cache"));
+    if (cli.misc_config.has("slice_cache_size"))
+        set_slice_cache_max_size(size_t(std::max(0, cli.misc_config.opt_int("slice_cache_size"))) << 20);
+
 #ifdef SLIC3R_GUI
     if (cli.misc_config.has("webdev")) {
         Utils::ServiceConfig::instance().set_webdev_enabled(cli.misc_config.opt_bool("webdev"));
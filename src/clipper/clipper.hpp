@@ -118,8 +118,16 @@ using DoublePoint = Eigen::Matrix<double, 2, 1, Eigen::DontAlign>;
 template<typename BaseType>
 using Allocator = tbb::scalable_allocator<BaseType>;
 //using Allocator = std::allocator<BaseType>;
-using Path      = std::vector<IntPoint, Allocator<IntPoint>>;
-using Paths     = std::vector<Path, Allocator<Path>>;
+#ifdef CLIPPERLIB_PATH_ALLOCATOR
+// Allocator of the input / output paths, so that Path may be the same type as the client's point vector.
+template<typename BaseType>
+using PathAllocator = CLIPPERLIB_PATH_ALLOCATOR<BaseType>;
+#else // CLIPPERLIB_PATH_ALLOCATOR
+template<typename BaseType>
+using PathAllocator = Allocator<BaseType>;
+#endif // CLIPPERLIB_PATH_ALLOCATOR
+using Path      = std::vector<IntPoint, PathAllocator<IntPoint>>;
+using Paths     = std::vector<Path, PathAllocator<Path>>;
 
 inline Path& operator <<(Path& poly, const IntPoint& p) {poly.push_back(p); return poly;}
 inline Paths& operator <<(Paths& polys, const Path& p) {polys.push_back(p); return polys;}
@@ -565,6 +573,8 @@ private:
   // y: index of the lowest point in the lowest contour
   IntPoint m_lowest;
   PolyNode m_polyNodes;
+  // Clipper engine cleaning up the offsetted contours, reused by subsequent calls to Execute().
+  Clipper m_clipper;
 
   void FixOrientations();
   void DoOffset(double delta);
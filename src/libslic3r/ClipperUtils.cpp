@@ -294,15 +294,11 @@ bool has_duplicate_points(const ClipperLib::PolyTree &polytree)
 
 // Offset CCW contours outside, CW contours (holes) inside.
 // Don't calculate union of the output paths.
+// The ClipperOffset engine and the out_this buffer are passed in to be reused by the caller, out is appended to.
 template<typename PathsProvider>
-static ClipperLib::Paths raw_offset(PathsProvider &&paths, float offset, ClipperLib::JoinType joinType, double miterLimit, ClipperLib::EndType endType = ClipperLib::etClosedPolygon)
+static void raw_offset(ClipperLib::ClipperOffset &co, ClipperLib::Paths &out_this, PathsProvider &&paths, float offset, ClipperLib::JoinType joinType, double miterLimit, ClipperLib::EndType endType, ClipperLib::Paths &out)
 {
-    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
-
-    ClipperLib::ClipperOffset co;
-    ClipperLib::Paths out;
-    out.reserve(paths.size());
-    ClipperLib::Paths out_this;
+    out.reserve(out.size() + paths.size());
     if (joinType == jtRound)
         co.ArcTolerance = miterLimit;
     else
@@ -323,6 +319,17 @@ static ClipperLib::Paths raw_offset(PathsProvider &&paths, float offset, Clipper
         }
         append(out, std::move(out_this));
     }
+}
+
+template<typename PathsProvider>
+static ClipperLib::Paths raw_offset(PathsProvider &&paths, float offset, ClipperLib::JoinType joinType, double miterLimit, ClipperLib::EndType endType = ClipperLib::etClosedPolygon)
+{
+    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
+
+    ClipperLib::ClipperOffset co;
+    ClipperLib::Paths out;
+    ClipperLib::Paths out_this;
+    raw_offset(co, out_this, std::forward<PathsProvider>(paths), offset, joinType, miterLimit, endType, out);
     return out;
 }
 
@@ -827,6 +834,180 @@ Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPol
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctXor, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
 
+// Clipper engines and scratch buffers shared by all ClipperPipeline operations executed by a single thread.
+// The engines are cleared, but not destroyed between the operations, thus the capacity of their internal vectors
+// (local minima, joins, intersections, offset normals ...) is retained.
+struct ClipperPipelineWorkspace
+{
+    ClipperLib::Clipper         clipper;
+    ClipperLib::ClipperOffset   offsetter;
+    // Result of the last operation, swapped with ClipperPipeline::m_paths.
+    ClipperLib::Paths           paths;
+    // Safety offsetted clipping paths.
+    ClipperLib::Paths           paths_offset;
+    ClipperLib::Paths           paths_offset_this;
+    ClipperLib::PolyTree        polytree;
+};
+
+static ClipperPipelineWorkspace& clipper_pipeline_workspace()
+{
+    static thread_local ClipperPipelineWorkspace workspace;
+    // Clipper throws on numerical overflow, possibly leaving the engines filled. Clear them before reuse.
+    workspace.clipper.Clear();
+    workspace.clipper.ReverseSolution(false);
+    return workspace;
+}
+
+ClipperPipeline::ClipperPipeline(const Slic3r::Polygons &subject)
+{
+    m_paths.reserve(subject.size());
+    for (const Polygon &polygon : subject)
+        m_paths.emplace_back(polygon.points);
+}
+
+ClipperPipeline::ClipperPipeline(Slic3r::Polygons &&subject)
+{
+    m_paths.reserve(subject.size());
+    for (Polygon &polygon : subject)
+        m_paths.emplace_back(std::move(polygon.points));
+}
+
+ClipperPipeline::ClipperPipeline(const Slic3r::ExPolygons &subject)
+{
+    ClipperUtils::ExPolygonsProvider provider(subject);
+    m_paths.reserve(provider.size());
+    for (const Points &path : provider)
+        m_paths.emplace_back(path);
+}
+
+ClipperPipeline::ClipperPipeline(const Slic3r::Surfaces &subject)
+{
+    ClipperUtils::SurfacesProvider provider(subject);
+    m_paths.reserve(provider.size());
+    for (const Points &path : provider)
+        m_paths.emplace_back(path);
+}
+
+template<typename PathsProvider>
+ClipperPipeline& ClipperPipeline::boolean_op(ClipperLib::ClipType clip_type, PathsProvider &&clip, ApplySafetyOffset do_safety_offset)
+{
+    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
+
+    // Safety offset only allowed on intersection and difference.
+    assert(do_safety_offset == ApplySafetyOffset::No || clip_type != ClipperLib::ctUnion);
+    if (m_paths.empty() && clip_type != ClipperLib::ctUnion)
+        // Nothing to clip.
+        return *this;
+
+    ClipperPipelineWorkspace &ws = clipper_pipeline_workspace();
+    ws.clipper.AddPaths(m_paths, ClipperLib::ptSubject, true);
+    if (do_safety_offset == ApplySafetyOffset::Yes) {
+        ws.paths_offset.clear();
+        raw_offset(ws.offsetter, ws.paths_offset_this, std::forward<PathsProvider>(clip), ClipperSafetyOffset, DefaultJoinType, DefaultMiterLimit, ClipperLib::etClosedPolygon, ws.paths_offset);
+        ws.offsetter.Clear();
+        ws.clipper.AddPaths(ws.paths_offset, ClipperLib::ptClip, true);
+    } else
+        ws.clipper.AddPaths(std::forward<PathsProvider>(clip), ClipperLib::ptClip, true);
+    ws.clipper.Execute(clip_type, ws.paths, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    ws.clipper.Clear();
+    m_paths.swap(ws.paths);
+    m_normalized = true;
+    return *this;
+}
+
+ClipperPipeline& ClipperPipeline::union_(ClipperLib::PolyFillType fill_type)
+{
+    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
+
+    if (! m_paths.empty()) {
+        ClipperPipelineWorkspace &ws = clipper_pipeline_workspace();
+        ws.clipper.AddPaths(m_paths, ClipperLib::ptSubject, true);
+        ws.clipper.Execute(ClipperLib::ctUnion, ws.paths, fill_type, fill_type);
+        ws.clipper.Clear();
+        m_paths.swap(ws.paths);
+    }
+    m_normalized = true;
+    return *this;
+}
+
+ClipperPipeline& ClipperPipeline::union_(const Slic3r::Polygons &subject2)
+    { return this->boolean_op(ClipperLib::ctUnion, ClipperUtils::PolygonsProvider(subject2), ApplySafetyOffset::No); }
+ClipperPipeline& ClipperPipeline::union_(const Slic3r::ExPolygons &subject2)
+    { return this->boolean_op(ClipperLib::ctUnion, ClipperUtils::ExPolygonsProvider(subject2), ApplySafetyOffset::No); }
+ClipperPipeline& ClipperPipeline::diff(const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctDifference, ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+ClipperPipeline& ClipperPipeline::diff(const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctDifference, ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+ClipperPipeline& ClipperPipeline::diff(const Slic3r::Surfaces &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctDifference, ClipperUtils::SurfacesProvider(clip), do_safety_offset); }
+ClipperPipeline& ClipperPipeline::intersection(const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctIntersection, ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+ClipperPipeline& ClipperPipeline::intersection(const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctIntersection, ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+ClipperPipeline& ClipperPipeline::intersection(const Slic3r::Surfaces &clip, ApplySafetyOffset do_safety_offset)
+    { return this->boolean_op(ClipperLib::ctIntersection, ClipperUtils::SurfacesProvider(clip), do_safety_offset); }
+
+// Equivalent to offset_paths(), however the normalized paths are offsetted by a single ClipperOffset call, which is possible
+// for normalized paths: The outer contours are CCW, the holes are CW oriented and there are no overlaps.
+// offset_paths() offsets the paths one by one, running a Clipper union for each of them, and then unites the result.
+// The input paths, which may overlap, are offsetted by offset_paths().
+ClipperPipeline& ClipperPipeline::offset(const float delta, ClipperLib::JoinType joinType, double miterLimit)
+{
+    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
+
+    assert(delta != 0);
+    if (! m_normalized) {
+        // Offset the input paths one by one and unite the results, as offset(const Polygons&) does, so that the result
+        // does not depend on the input paths overlapping or touching each other. Call union_() first to offset their union.
+        if (! m_paths.empty())
+            m_paths = offset_paths<ClipperLib::Paths>(m_paths, delta, joinType, miterLimit);
+        m_normalized = true;
+        return *this;
+    }
+    if (m_paths.empty())
+        return *this;
+
+    ClipperPipelineWorkspace &ws = clipper_pipeline_workspace();
+    ClipperLib::ClipperOffset &co = ws.offsetter;
+    co.Clear();
+    if (joinType == jtRound)
+        co.ArcTolerance = miterLimit;
+    else
+        co.MiterLimit = miterLimit;
+    co.ShortestEdgeLength = std::abs(delta * ClipperOffsetShortestEdgeFactor);
+    co.AddPaths(m_paths, joinType, ClipperLib::etClosedPolygon);
+    // Execute() unites the offsetted paths, for the negative offset it also removes the inverted contours.
+    co.Execute(ws.paths, delta);
+    co.Clear();
+    m_paths.swap(ws.paths);
+    return *this;
+}
+
+Slic3r::Polygons ClipperPipeline::polygons()
+{
+    Polygons out = to_polygons(std::move(m_paths));
+    m_paths.clear();
+    return out;
+}
+
+Slic3r::ExPolygons ClipperPipeline::expolygons()
+{
+    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
+
+    ExPolygons out;
+    if (! m_paths.empty()) {
+        // Perform an additional Union operation to generate the PolyTree ordering, see clipper_do_polytree().
+        ClipperPipelineWorkspace &ws = clipper_pipeline_workspace();
+        ws.clipper.AddPaths(m_paths, ClipperLib::ptSubject, true);
+        ws.clipper.Execute(ClipperLib::ctUnion, ws.polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ws.clipper.Clear();
+        out = PolyTreeToExPolygons(std::move(ws.polytree));
+        ws.polytree.Clear();
+        m_paths.clear();
+    }
+    return out;
+}
+
 template<typename PathsProvider1, typename PathsProvider2>
 Polylines _clipper_pl_open(ClipperLib::ClipType clipType, PathsProvider1 &&subject, PathsProvider2 &&clip)
 {
@@ -544,6 +544,64 @@ Slic3r::Polygons union_parallel_reduce(const Slic3r::Polygons &subject);
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygon &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 
+// Chain of boolean operations and offsets, which keeps the intermediate results in the ClipperLib::Paths form.
+// Compared to chaining the free functions above (for example opening_ex(diff_ex(a, b), delta)), the intermediate
+// results are not converted to ExPolygons (which costs an additional Clipper union into a PolyTree) and back,
+// only the final result is converted once by polygons() or expolygons().
+// All the pipelines executed by a single thread share a thread local set of Clipper engines and scratch buffers,
+// which are cleared, but not released between the operations. Together with the thread local pools of
+// tbb::scalable_allocator this removes most of the allocations from the hot loops processing layers in parallel.
+// The results are equivalent to those of the free functions, with the exception that the offsets are applied
+// to the union of the paths at once, not to the individual Polygons or ExPolygons.
+class ClipperPipeline
+{
+public:
+    ClipperPipeline() = default;
+    explicit ClipperPipeline(const Slic3r::Polygons &subject);
+    explicit ClipperPipeline(Slic3r::Polygons &&subject);
+    explicit ClipperPipeline(const Slic3r::ExPolygons &subject);
+    explicit ClipperPipeline(const Slic3r::Surfaces &subject);
+    explicit ClipperPipeline(ClipperLib::Paths &&subject) : m_paths(std::move(subject)) {}
+
+    // Union of the current paths, may be used to normalize the input.
+    ClipperPipeline&    union_(ClipperLib::PolyFillType fill_type = ClipperLib::pftNonZero);
+    ClipperPipeline&    union_(const Slic3r::Polygons &subject2);
+    ClipperPipeline&    union_(const Slic3r::ExPolygons &subject2);
+    // Safety offset is applied to the clipping polygons only.
+    ClipperPipeline&    diff(const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperPipeline&    diff(const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperPipeline&    diff(const Slic3r::Surfaces &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperPipeline&    intersection(const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperPipeline&    intersection(const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperPipeline&    intersection(const Slic3r::Surfaces &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    // Offsetting the input paths offsets them one by one and unites the results, same as offset(const Polygons&):
+    // Overlapping or touching input paths are not merged before the offset, call union_() first to merge them.
+    // Offsetting the normalized output of another operation runs a single ClipperOffset pass.
+    ClipperPipeline&    offset(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit);
+    ClipperPipeline&    expand(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit)
+        { assert(delta > 0); return this->offset(delta, joinType, miterLimit); }
+    ClipperPipeline&    shrink(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit)
+        { assert(delta > 0); return this->offset(- delta, joinType, miterLimit); }
+    ClipperPipeline&    opening(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit)
+        { return this->shrink(delta, joinType, miterLimit).expand(delta, joinType, miterLimit); }
+    ClipperPipeline&    closing(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit)
+        { return this->expand(delta, joinType, miterLimit).shrink(delta, joinType, miterLimit); }
+
+    bool                empty() const { return m_paths.empty(); }
+    // Convert the result, the pipeline is left empty.
+    Slic3r::Polygons    polygons();
+    Slic3r::ExPolygons  expolygons();
+
+private:
+    template<typename PathsProvider>
+    ClipperPipeline&    boolean_op(ClipperLib::ClipType clip_type, PathsProvider &&clip, ApplySafetyOffset do_safety_offset);
+
+    ClipperLib::Paths   m_paths;
+    // m_paths are the output of a Clipper operation, thus the outer contours are CCW, the holes are CW oriented
+    // and there are no overlaps. False for the input paths.
+    bool                m_normalized { false };
+};
+
 ClipperLib::PolyNodes order_nodes(const ClipperLib::PolyNodes &nodes);
 
 // Implementing generalized loop (foreach) over a list of nodes which can be
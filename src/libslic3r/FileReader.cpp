@@ -24,7 +24,8 @@ bool is_project_file(const std::string& input_file)
 } 
 
 // Loading model from a file, it may be a simple geometry file as STL or OBJ, however it may be a project file as well.
-static Model read_model_from_file(const std::string& input_file, LoadAttributes options, const std::optional<std::pair<double, double>>& step_deflections = std::nullopt)
+static Model read_model_from_file(const std::string& input_file, LoadAttributes options, const std::optional<std::pair<double, double>>& step_deflections = std::nullopt,
+                                  std::function<void(int)> progress_fn = nullptr, std::function<void()> throw_on_cancel_fn = nullptr)
 {
     Model model;
 
@@ -33,7 +34,7 @@ static Model read_model_from_file(const std::string& input_file, LoadAttributes
 
     bool result = false;
     if (boost::algorithm::iends_with(input_file, ".stl"))
-        result = load_stl(input_file.c_str(), &model);
+        result = load_stl(input_file.c_str(), &model, nullptr, progress_fn, throw_on_cancel_fn);
     else if (boost::algorithm::iends_with(input_file, ".obj"))
         result = load_obj(input_file.c_str(), &model);
     else if (boost::algorithm::iends_with(input_file, ".step") || boost::algorithm::iends_with(input_file, ".stp")) {
@@ -50,7 +51,7 @@ static Model read_model_from_file(const std::string& input_file, LoadAttributes
     } else if (boost::algorithm::iends_with(input_file, ".svg"))
         result = load_svg(input_file, model);
     else if (boost::ends_with(input_file, ".printRequest"))
-        result = load_printRequest(input_file.c_str(), &model);
+        result = load_printRequest(input_file.c_str(), &model, progress_fn, throw_on_cancel_fn);
     else
         throw Slic3r::RuntimeError(L("Unknown file format. Input file must have .stl, .obj, .step/.stp, .svg, .amf(.xml) or extension .3mf(.zip)."));
 
@@ -205,9 +206,11 @@ static int removed_objects_with_zero_volume(Model& model)
 Model load_model(const std::string& input_file,
                  LoadAttributes options/* = LoadAttribute::AddDefaultInstances*/, 
                  LoadStats* stats/*= nullptr*/,
-                 std::optional<std::pair<double, double>> step_deflections/* = std::nullopt*/)
+                 std::optional<std::pair<double, double>> step_deflections/* = std::nullopt*/,
+                 std::function<void(int)> progress_fn/* = nullptr*/,
+                 std::function<void()> throw_on_cancel_fn/* = nullptr*/)
 {
-    Model model = read_model_from_file(input_file, options, step_deflections);
+    Model model = read_model_from_file(input_file, options, step_deflections, progress_fn, throw_on_cancel_fn);
 
     for (auto obj : model.objects)
         if (obj->name.empty())
@@ -2,6 +2,7 @@
 
 #include "PrintConfig.hpp"
 #include "enum_bitmask.hpp"
+#include <functional>
 #include <utility>
 #include <optional>
 
@@ -34,10 +35,13 @@ namespace FileReader
     // Load model from input file and fill statistics if it's required.
     // In respect to the params will be applied needed convertions over the model.
     // Exceptions don't catched inside
+    // progress_fn and throw_on_cancel_fn are passed to the STL import, which may be canceled by an exception thrown by throw_on_cancel_fn.
     Model           load_model(const std::string& input_file,
                                LoadAttributes options = LoadAttribute::AddDefaultInstances, 
                                LoadStats* statistics = nullptr,
-                               std::optional<std::pair<double, double>> step_deflections = std::nullopt);
+                               std::optional<std::pair<double, double>> step_deflections = std::nullopt,
+                               std::function<void(int)> progress_fn = nullptr,
+                               std::function<void()> throw_on_cancel_fn = nullptr);
 
     // Load model, config and config substitutions from input file and fill statistics if it's required.
     // Exceptions don't catched inside
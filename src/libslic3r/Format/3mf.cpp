@@ -12,6 +12,7 @@
 
 #include "3mf.hpp"
 
+#include <atomic>
 #include <limits>
 #include <stdexcept>
 #include <optional>
@@ -46,6 +47,9 @@ namespace pt = boost::property_tree;
 
 #include <fast_float.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "nlohmann/json.hpp"
 
 // Slightly faster than sprintf("%.9g"), but there is an issue with the karma floating point formatter,
@@ -345,6 +349,61 @@ bool is_valid_object_type(const std::string& type)
 
 namespace Slic3r {
 
+    // Parser of the <vertex> and <triangle> elements for the fast path of loading the <vertices> and <triangles> blocks.
+    // Only the subset of XML produced by 3MF exporters is accepted: empty elements of a single type with quoted attributes
+    // without character references, separated by white space. For anything else false is returned and the block has to be parsed by expat.
+    // attr_fn(name, value_begin, value_end) is called for each attribute, element_fn() at the end of each element.
+    template<typename AttrFn, typename ElementFn>
+    static bool for_each_mesh_xml_element(const char *begin, const char *end, const char *element_name, AttrFn attr_fn, ElementFn element_fn)
+    {
+        auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+        const size_t element_name_len = strlen(element_name);
+        const char  *p = begin;
+        for (;;) {
+            while (p != end && is_space(*p))
+                ++ p;
+            if (p == end)
+                return true;
+            if (*p != '<' || size_t(end - p) <= element_name_len || memcmp(p + 1, element_name, element_name_len) != 0)
+                return false;
+            p += element_name_len + 1;
+            for (;;) {
+                const char *attr_begin = p;
+                while (p != end && is_space(*p))
+                    ++ p;
+                if (p == end)
+                    return false;
+                if (*p == '/') {
+                    if (++ p == end || *p != '>')
+                        return false;
+                    ++ p;
+                    break;
+                }
+                // Attributes have to be separated by white space from the element name and from each other.
+                if (p == attr_begin)
+                    return false;
+                const char *name_begin = p;
+                while (p != end && *p != '=' && *p != '/' && *p != '>' && ! is_space(*p))
+                    ++ p;
+                const char *name_end = p;
+                while (p != end && is_space(*p))
+                    ++ p;
+                if (p == end || *p != '=' || name_begin == name_end)
+                    return false;
+                for (++ p; p != end && is_space(*p); ++ p) ;
+                if (p == end || (*p != '"' && *p != '\''))
+                    return false;
+                const char *value_begin = ++ p;
+                const char *value_end   = static_cast<const char*>(memchr(value_begin, p[-1], end - value_begin));
+                if (value_end == nullptr || memchr(value_begin, '&', value_end - value_begin) != nullptr)
+                    return false;
+                attr_fn(std::string_view(name_begin, name_end - name_begin), value_begin, value_end);
+                p = value_end + 1;
+            }
+            element_fn();
+        }
+    }
+
     // Base class with error messages management
     class _3MF_Base
     {
@@ -545,6 +604,17 @@ namespace Slic3r {
         std::string m_start_part_path;
         std::string m_model_path;
 
+        // The content of the <vertices> and <triangles> blocks of the .model file is not passed to expat, it is parsed in parallel.
+        enum class MeshBlock { None, Vertices, Triangles };
+        // Block, which content is being received.
+        MeshBlock   m_mesh_block { MeshBlock::None };
+        // Block opened by the last start tag passed to expat, set by _handle_start_vertices() and _handle_start_triangles().
+        MeshBlock   m_mesh_block_opened { MeshBlock::None };
+        // Part of the .model file received, but not yet passed to expat or parsed.
+        std::string m_model_xml_buffer;
+        // Position in m_model_xml_buffer, from which to continue searching for tags.
+        size_t      m_model_xml_scan_pos { 0 };
+
     public:
         _3MF_Importer();
         ~_3MF_Importer();
@@ -569,6 +639,15 @@ namespace Slic3r {
         bool _load_model_from_file(const std::string& filename, Model& model, DynamicPrintConfig& config, ConfigSubstitutionContext& config_substitutions);
         bool _extract_relationships_from_archive(mz_zip_archive &archive, const mz_zip_archive_file_stat &stat);
         bool _extract_model_from_archive(mz_zip_archive &archive, const mz_zip_archive_file_stat &stat);
+        // Pass a piece of the .model file to expat, parse the content of the <vertices> and <triangles> blocks in parallel.
+        // Throws Slic3r::FileIOError on a parsing error.
+        void _parse_model_xml(const char *data, size_t size, bool is_final, const char *filename);
+        void _feed_xml_parser(const char *data, size_t size, bool is_final, const char *filename);
+        // Parse complete elements of a <vertices> or <triangles> block, append them to m_curr_object.geometry.
+        // Returns false if the data has to be parsed by expat.
+        bool _parse_mesh_block(MeshBlock block, const char *begin, const char *end);
+        static bool _parse_vertices_chunk(const char *begin, const char *end, Geometry &geometry);
+        static bool _parse_triangles_chunk(const char *begin, const char *end, Geometry &geometry);
         bool _is_svg_shape_file(const std::string &filename) const;
         void _extract_cut_information_from_archive(mz_zip_archive& archive, const mz_zip_archive_file_stat& stat, ConfigSubstitutionContext& config_substitutions);
         void _extract_layer_heights_profile_config_from_archive(mz_zip_archive& archive, const mz_zip_archive_file_stat& stat);
@@ -1107,6 +1186,194 @@ namespace Slic3r {
         return true;
     }
 
+    void _3MF_Importer::_parse_model_xml(const char *data, size_t size, bool is_final, const char *filename)
+    {
+        // Complete elements of a block are parsed once this amount of data is buffered, limiting the memory footprint.
+        static constexpr const size_t mesh_block_parse_size = 64 * 1024 * 1024;
+
+        std::string &buffer = m_model_xml_buffer;
+        buffer.append(data, size);
+        // Start of the data not yet passed to expat nor parsed.
+        size_t pos  = 0;
+        size_t scan = m_model_xml_scan_pos;
+        auto   parse_mesh_block = [this, &buffer, &pos, &scan](size_t end) {
+            if (_parse_mesh_block(m_mesh_block, buffer.data() + pos, buffer.data() + end))
+                pos = end;
+            else {
+                // Let expat parse the rest of the block.
+                m_mesh_block = MeshBlock::None;
+                scan = pos;
+            }
+        };
+        for (;;) {
+            if (m_mesh_block == MeshBlock::None) {
+                const size_t tag_begin = buffer.find('<', scan);
+                const size_t tag_end   = tag_begin == std::string::npos ? std::string::npos : buffer.find('>', tag_begin);
+                if (tag_end == std::string::npos) {
+                    // Keep the incomplete tag for the next round.
+                    const size_t n = tag_begin == std::string::npos ? buffer.size() : tag_begin;
+                    _feed_xml_parser(buffer.data() + pos, n - pos, false, filename);
+                    pos = scan = n;
+                    break;
+                }
+                scan = tag_end + 1;
+                MeshBlock block = MeshBlock::None;
+                auto is_start_tag = [&buffer, tag_begin, tag_end](const char *tag) {
+                    const size_t len = strlen(tag);
+                    return tag_end > tag_begin + len && buffer.compare(tag_begin + 1, len, tag) == 0 &&
+                           (buffer[tag_begin + len + 1] == '>' || isspace((unsigned char)buffer[tag_begin + len + 1])) && buffer[tag_end - 1] != '/';
+                };
+                if (is_start_tag(VERTICES_TAG))
+                    block = MeshBlock::Vertices;
+                else if (is_start_tag(TRIANGLES_TAG))
+                    block = MeshBlock::Triangles;
+                if (block != MeshBlock::None) {
+                    m_mesh_block_opened = MeshBlock::None;
+                    _feed_xml_parser(buffer.data() + pos, scan - pos, false, filename);
+                    pos = scan;
+                    // Tags inside comments or CDATA sections are not reported by expat.
+                    if (m_mesh_block_opened == block)
+                        m_mesh_block = block;
+                }
+            } else {
+                const std::string end_tag   = std::string("</") + (m_mesh_block == MeshBlock::Vertices ? VERTICES_TAG : TRIANGLES_TAG);
+                const size_t      block_end = buffer.find(end_tag, scan);
+                if (block_end != std::string::npos) {
+                    parse_mesh_block(block_end);
+                    if (m_mesh_block != MeshBlock::None) {
+                        // The end tag is passed to expat with the data following it.
+                        m_mesh_block = MeshBlock::None;
+                        scan = pos;
+                    }
+                    continue;
+                }
+                if (buffer.size() - pos >= mesh_block_parse_size) {
+                    if (size_t last_element = buffer.rfind('<'); last_element != std::string::npos && last_element > pos) {
+                        parse_mesh_block(last_element);
+                        if (m_mesh_block == MeshBlock::None)
+                            continue;
+                    }
+                }
+                scan = std::max(pos, buffer.size() - std::min(buffer.size(), end_tag.size()));
+                break;
+            }
+        }
+        buffer.erase(0, pos);
+        m_model_xml_scan_pos = scan - pos;
+
+        if (is_final) {
+            _feed_xml_parser(buffer.data(), buffer.size(), true, filename);
+            buffer.clear();
+            m_model_xml_scan_pos = 0;
+        }
+    }
+
+    void _3MF_Importer::_feed_xml_parser(const char *data, size_t size, bool is_final, const char *filename)
+    {
+        do {
+            // XML_Parse() accepts int sized buffers only.
+            const size_t n = std::min<size_t>(size, 1 << 30);
+            if (! XML_Parse(m_xml_parser, data, int(n), (is_final && n == size) ? 1 : 0) || parse_error()) {
+                char error_buf[1024];
+                ::snprintf(error_buf, sizeof(error_buf), "Error (%s) while parsing '%s' at line %d", parse_error_message(), filename, (int)XML_GetCurrentLineNumber(m_xml_parser));
+                throw Slic3r::FileIOError(error_buf);
+            }
+            data += n;
+            size -= n;
+        } while (size > 0);
+    }
+
+    bool _3MF_Importer::_parse_mesh_block(MeshBlock block, const char *begin, const char *end)
+    {
+        assert(block != MeshBlock::None);
+        // Split the data into chunks starting with an element.
+        static constexpr const size_t chunk_size = 1024 * 1024;
+        std::vector<const char*> chunk_begins { begin };
+        for (const char *p = begin + chunk_size; p < end; p += chunk_size) {
+            p = static_cast<const char*>(memchr(p, '<', end - p));
+            if (p == nullptr)
+                break;
+            chunk_begins.emplace_back(p);
+        }
+        chunk_begins.emplace_back(end);
+
+        std::vector<Geometry> chunks(chunk_begins.size() - 1);
+        std::atomic<bool>     failed { false };
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1), [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_idx = range.begin(); chunk_idx < range.end() && ! failed; ++ chunk_idx)
+                if (! (block == MeshBlock::Vertices ? _parse_vertices_chunk : _parse_triangles_chunk)(chunk_begins[chunk_idx], chunk_begins[chunk_idx + 1], chunks[chunk_idx]))
+                    failed = true;
+        });
+        if (failed)
+            return false;
+
+        Geometry &geometry = m_curr_object.geometry;
+        for (Geometry &chunk : chunks) {
+            if (block == MeshBlock::Vertices) {
+                geometry.vertices.reserve(geometry.vertices.size() + chunk.vertices.size());
+                for (const Vec3f &v : chunk.vertices)
+                    geometry.vertices.emplace_back(m_unit_factor * v.x(), m_unit_factor * v.y(), m_unit_factor * v.z());
+            } else {
+                append(geometry.triangles, std::move(chunk.triangles));
+                append(geometry.custom_supports, std::move(chunk.custom_supports));
+                append(geometry.custom_seam, std::move(chunk.custom_seam));
+                append(geometry.mm_segmentation, std::move(chunk.mm_segmentation));
+                append(geometry.fuzzy_skin, std::move(chunk.fuzzy_skin));
+            }
+        }
+        return true;
+    }
+
+    bool _3MF_Importer::_parse_vertices_chunk(const char *begin, const char *end, Geometry &geometry)
+    {
+        // Same as _handle_start_vertex(): missing values are set equal to ZERO
+        Vec3f vertex = Vec3f::Zero();
+        return for_each_mesh_xml_element(begin, end, VERTEX_TAG,
+            [&vertex](std::string_view name, const char *value_begin, const char *value_end) {
+                if (name.size() == 1 && name[0] >= 'x' && name[0] <= 'z')
+                    fast_float::from_chars(value_begin, value_end, vertex[name[0] - 'x']);
+            },
+            [&vertex, &geometry]() {
+                geometry.vertices.emplace_back(vertex);
+                vertex = Vec3f::Zero();
+            });
+    }
+
+    bool _3MF_Importer::_parse_triangles_chunk(const char *begin, const char *end, Geometry &geometry)
+    {
+        // Same as _handle_start_triangle(): missing values are set equal to ZERO, attributes p1, p2, p3 and pid are ignored.
+        Vec3i       triangle = Vec3i::Zero();
+        std::string custom_supports, custom_seam, mm_segmentation, paint_color, fuzzy_skin;
+        return for_each_mesh_xml_element(begin, end, TRIANGLE_TAG,
+            [&](std::string_view name, const char *value_begin, const char *value_end) {
+                if (name == V1_ATTR || name == V2_ATTR || name == V3_ATTR)
+                    boost::spirit::qi::parse(value_begin, value_end, boost::spirit::qi::int_, triangle[name[1] - '1']);
+                else if (name == CUSTOM_SUPPORTS_ATTR)
+                    custom_supports.assign(value_begin, value_end);
+                else if (name == CUSTOM_SEAM_ATTR)
+                    custom_seam.assign(value_begin, value_end);
+                else if (name == MM_SEGMENTATION_ATTR)
+                    mm_segmentation.assign(value_begin, value_end);
+                else if (name == "paint_color")
+                    paint_color.assign(value_begin, value_end);
+                else if (name == FUZZY_SKIN_ATTR)
+                    fuzzy_skin.assign(value_begin, value_end);
+            },
+            [&]() {
+                geometry.triangles.emplace_back(triangle);
+                geometry.custom_supports.emplace_back(std::move(custom_supports));
+                geometry.custom_seam.emplace_back(std::move(custom_seam));
+                geometry.fuzzy_skin.emplace_back(std::move(fuzzy_skin));
+                geometry.mm_segmentation.emplace_back(std::move(mm_segmentation.empty() ? paint_color : mm_segmentation));
+                triangle = Vec3i::Zero();
+                custom_supports.clear();
+                custom_seam.clear();
+                mm_segmentation.clear();
+                paint_color.clear();
+                fuzzy_skin.clear();
+            });
+    }
+
     bool _3MF_Importer::_is_svg_shape_file(const std::string &name) const { 
         return boost::starts_with(name, MODEL_FOLDER) && boost::ends_with(name, ".svg");
     }
@@ -1130,16 +1397,19 @@ namespace Slic3r {
         XML_SetElementHandler(m_xml_parser, _3MF_Importer::_handle_start_model_xml_element, _3MF_Importer::_handle_end_model_xml_element);
         XML_SetCharacterDataHandler(m_xml_parser, _3MF_Importer::_handle_model_xml_characters);
 
+        m_mesh_block = MeshBlock::None;
+        m_model_xml_buffer.clear();
+        m_model_xml_scan_pos = 0;
+
         struct CallbackData
         {
-            XML_Parser& parser;
             _3MF_Importer& importer;
             const mz_zip_archive_file_stat& stat;
 
-            CallbackData(XML_Parser& parser, _3MF_Importer& importer, const mz_zip_archive_file_stat& stat) : parser(parser), importer(importer), stat(stat) {}
+            CallbackData(_3MF_Importer& importer, const mz_zip_archive_file_stat& stat) : importer(importer), stat(stat) {}
         };
 
-        CallbackData data(m_xml_parser, *this, stat);
+        CallbackData data(*this, stat);
 
         mz_bool res = 0;
 
@@ -1147,12 +1417,7 @@ namespace Slic3r {
         {
             res = mz_zip_reader_extract_to_callback(&archive, stat.m_file_index, [](void* pOpaque, mz_uint64 file_ofs, const void* pBuf, size_t n)->size_t {
                 CallbackData* data = (CallbackData*)pOpaque;
-                if (!XML_Parse(data->parser, (const char*)pBuf, (int)n, (file_ofs + n == data->stat.m_uncomp_size) ? 1 : 0) || data->importer.parse_error()) {
-                    char error_buf[1024];
-                    ::sprintf(error_buf, "Error (%s) while parsing '%s' at line %d", data->importer.parse_error_message(), data->stat.m_filename, (int)XML_GetCurrentLineNumber(data->parser));
-                    throw Slic3r::FileIOError(error_buf);
-                }
-
+                data->importer._parse_model_xml((const char*)pBuf, n, file_ofs + n == data->stat.m_uncomp_size, data->stat.m_filename);
                 return n;
                 }, &data, 0);
         }
@@ -2074,6 +2339,7 @@ namespace Slic3r {
     {
         // reset current vertices
         m_curr_object.geometry.vertices.clear();
+        m_mesh_block_opened = MeshBlock::Vertices;
         return true;
     }
 
@@ -2104,6 +2370,7 @@ namespace Slic3r {
     {
         // reset current triangles
         m_curr_object.geometry.triangles.clear();
+        m_mesh_block_opened = MeshBlock::Triangles;
         return true;
     }
 
@@ -3406,23 +3673,58 @@ namespace Slic3r {
 
     bool _3MF_Exporter::_add_mesh_to_object_stream(mz_zip_writer_staged_context &context, ModelObject& object, VolumeToOffsetsMap& volumes_offsets)
     {
-        std::string output_buffer;
-        output_buffer += "   <";
-        output_buffer += MESH_TAG;
-        output_buffer += ">\n    <";
-        output_buffer += VERTICES_TAG;
-        output_buffer += ">\n";
-
-        auto flush = [this, &output_buffer, &context](bool force = false) {
-            if ((force && ! output_buffer.empty()) || output_buffer.size() >= 65536 * 16) {
-                if (! mz_zip_writer_add_staged_data(&context, output_buffer.data(), output_buffer.size())) {
-                    add_error("Error during writing or compression");
-                    return false;
-                }
-                output_buffer.clear();
-            }
-            return true;
+        // The <vertices> and <triangles> blocks are split into chunks of vertices and triangles of a single volume,
+        // which are formatted in parallel. Chunks of large meshes are compressed in parallel as well.
+        struct Chunk
+        {
+            const ModelVolume *volume;
+            bool               triangles;
+            int                begin;
+            int                end;
         };
+        static constexpr const int    chunk_size            = 65536;
+        // Number of chunks formatted and compressed before writing them, limits the memory footprint.
+        static constexpr const size_t chunks_per_batch      = 64;
+        // Smaller meshes are compressed by the ZIP writer on a single thread, producing slightly smaller files.
+        static constexpr const size_t min_chunks_compressed = 4;
+
+        std::vector<Chunk> vertices_chunks;
+        unsigned int vertices_count = 0;
+        for (ModelVolume* volume : object.volumes) {
+            if (volume == nullptr)
+                continue;
+
+            volumes_offsets.insert({ volume, Offsets(vertices_count) });
+
+            const indexed_triangle_set &its = volume->mesh().its;
+            if (its.vertices.empty()) {
+                add_error("Found invalid mesh");
+                return false;
+            }
+
+            vertices_count += (int)its.vertices.size();
+            for (int i = 0; i < int(its.vertices.size()); i += chunk_size)
+                vertices_chunks.push_back({ volume, false, i, std::min(i + chunk_size, int(its.vertices.size())) });
+        }
+
+        std::vector<Chunk> triangles_chunks;
+        unsigned int triangles_count = 0;
+        for (ModelVolume* volume : object.volumes) {
+            if (volume == nullptr)
+                continue;
+
+            VolumeToOffsetsMap::iterator volume_it = volumes_offsets.find(volume);
+            assert(volume_it != volumes_offsets.end());
+
+            const indexed_triangle_set &its = volume->mesh().its;
+
+            // updates triangle offsets
+            volume_it->second.first_triangle_id = triangles_count;
+            triangles_count += (int)its.indices.size();
+            volume_it->second.last_triangle_id = triangles_count - 1;
+            for (int i = 0; i < int(its.indices.size()); i += chunk_size)
+                triangles_chunks.push_back({ volume, true, i, std::min(i + chunk_size, int(its.indices.size())) });
+        }
 
         auto format_coordinate = [](float f, char *buf) -> char* {
             assert(is_decimal_separator_point());
@@ -3454,25 +3756,12 @@ namespace Slic3r {
 #endif
         };
 
-        char buf[256];
-        unsigned int vertices_count = 0;
-        for (ModelVolume* volume : object.volumes) {
-            if (volume == nullptr)
-                continue;
-
-            volumes_offsets.insert({ volume, Offsets(vertices_count) });
-
-            const indexed_triangle_set &its = volume->mesh().its;
-            if (its.vertices.empty()) {
-                add_error("Found invalid mesh");
-                return false;
-            }
-
-            vertices_count += (int)its.vertices.size();
-
-            const Transform3d& matrix = volume->get_matrix();
-            for (const auto& vertex: its.vertices) {
-                Vec3f v = (matrix * vertex.cast<double>()).cast<float>();
+        auto format_vertices = [&format_coordinate](const Chunk &chunk, std::string &output_buffer) {
+            char buf[256];
+            const indexed_triangle_set &its    = chunk.volume->mesh().its;
+            const Transform3d          &matrix = chunk.volume->get_matrix();
+            for (int i = chunk.begin; i < chunk.end; ++ i) {
+                Vec3f v = (matrix * its.vertices[i].cast<double>()).cast<float>();
                 char *ptr = buf;
                 boost::spirit::karma::generate(ptr, boost::spirit::lit("     <") << VERTEX_TAG << " x=\"");
                 ptr = format_coordinate(v.x(), ptr);
@@ -3483,34 +3772,16 @@ namespace Slic3r {
                 boost::spirit::karma::generate(ptr, "\"/>\n");
                 *ptr = '\0';
                 output_buffer += buf;
-                if (! flush())
-                    return false;
             }
-        }
-
-        output_buffer += "    </";
-        output_buffer += VERTICES_TAG;
-        output_buffer += ">\n    <";
-        output_buffer += TRIANGLES_TAG;
-        output_buffer += ">\n";
-
-        unsigned int triangles_count = 0;
-        for (ModelVolume* volume : object.volumes) {
-            if (volume == nullptr)
-                continue;
-
-            bool is_left_handed = volume->is_left_handed();
-            VolumeToOffsetsMap::iterator volume_it = volumes_offsets.find(volume);
-            assert(volume_it != volumes_offsets.end());
-
-            const indexed_triangle_set &its = volume->mesh().its;
-
-            // updates triangle offsets
-            volume_it->second.first_triangle_id = triangles_count;
-            triangles_count += (int)its.indices.size();
-            volume_it->second.last_triangle_id = triangles_count - 1;
+        };
 
-            for (int i = 0; i < int(its.indices.size()); ++ i) {
+        auto format_triangles = [&volumes_offsets](const Chunk &chunk, std::string &output_buffer) {
+            char buf[256];
+            const ModelVolume          *volume         = chunk.volume;
+            const indexed_triangle_set &its            = volume->mesh().its;
+            const bool                  is_left_handed = volume->is_left_handed();
+            const unsigned int          first_vertex_id = volumes_offsets.find(volume)->second.first_vertex_id;
+            for (int i = chunk.begin; i < chunk.end; ++ i) {
                 {
                     const Vec3i &idx = its.indices[i];
                     char *ptr = buf;
@@ -3518,9 +3789,9 @@ namespace Slic3r {
                         " v1=\"" << boost::spirit::int_ <<
                         "\" v2=\"" << boost::spirit::int_ <<
                         "\" v3=\"" << boost::spirit::int_ << "\"",
-                        idx[is_left_handed ? 2 : 0] + volume_it->second.first_vertex_id,
-                        idx[1] + volume_it->second.first_vertex_id,
-                        idx[is_left_handed ? 0 : 2] + volume_it->second.first_vertex_id);
+                        idx[is_left_handed ? 2 : 0] + first_vertex_id,
+                        idx[1] + first_vertex_id,
+                        idx[is_left_handed ? 0 : 2] + first_vertex_id);
                     *ptr = '\0';
                     output_buffer += buf;
                 }
@@ -3562,20 +3833,61 @@ namespace Slic3r {
                 }
 
                 output_buffer += "/>\n";
+            }
+        };
 
-                if (! flush())
+        const bool compress = vertices_chunks.size() + triangles_chunks.size() >= min_chunks_compressed;
+        auto add_chunks = [this, &context, &format_vertices, &format_triangles, compress](const std::vector<Chunk> &chunks) {
+            std::vector<std::string>      texts;
+            std::vector<MZ_DeflatedChunk> deflated;
+            for (size_t batch_begin = 0; batch_begin < chunks.size(); batch_begin += chunks_per_batch) {
+                const size_t batch_end = std::min(batch_begin + chunks_per_batch, chunks.size());
+                texts.assign(batch_end - batch_begin, std::string());
+                deflated.assign(compress ? batch_end - batch_begin : 0, MZ_DeflatedChunk());
+                std::atomic<bool> compression_failed { false };
+                tbb::parallel_for(tbb::blocked_range<size_t>(batch_begin, batch_end, 1), [&](const tbb::blocked_range<size_t> &range) {
+                    for (size_t chunk_idx = range.begin(); chunk_idx < range.end(); ++ chunk_idx) {
+                        const Chunk &chunk = chunks[chunk_idx];
+                        std::string &text  = texts[chunk_idx - batch_begin];
+                        if (chunk.triangles)
+                            format_triangles(chunk, text);
+                        else
+                            format_vertices(chunk, text);
+                        if (compress) {
+                            if (! deflate_chunk(text.data(), text.size(), deflated[chunk_idx - batch_begin]))
+                                compression_failed = true;
+                            text = std::string();
+                        }
+                    }
+                });
+                if (compression_failed) {
+                    add_error("Error during writing or compression");
                     return false;
+                }
+                for (size_t i = 0; i < batch_end - batch_begin; ++ i)
+                    if (compress ?
+                        ! mz_zip_writer_add_staged_compressed_data(&context, deflated[i].data.data(), deflated[i].data.size(), deflated[i].uncomp_crc32, deflated[i].uncomp_size) :
+                        (! texts[i].empty() && ! mz_zip_writer_add_staged_data(&context, texts[i].data(), texts[i].size()))) {
+                        add_error("Error during writing or compression");
+                        return false;
+                    }
             }
-        }
+            return true;
+        };
 
-        output_buffer += "    </";
-        output_buffer += TRIANGLES_TAG;
-        output_buffer += ">\n   </";
-        output_buffer += MESH_TAG;
-        output_buffer += ">\n";
+        auto add_text = [this, &context](const std::string &text) {
+            if (! mz_zip_writer_add_staged_data(&context, text.data(), text.size())) {
+                add_error("Error during writing or compression");
+                return false;
+            }
+            return true;
+        };
 
-        // Force flush.
-        return flush(true);
+        return add_text(std::string("   <") + MESH_TAG + ">\n    <" + VERTICES_TAG + ">\n") &&
+               add_chunks(vertices_chunks) &&
+               add_text(std::string("    </") + VERTICES_TAG + ">\n    <" + TRIANGLES_TAG + ">\n") &&
+               add_chunks(triangles_chunks) &&
+               add_text(std::string("    </") + TRIANGLES_TAG + ">\n   </" + MESH_TAG + ">\n");
     }
 
     void _3MF_Exporter::add_transformation(std::stringstream &stream, const Transform3d &tr)
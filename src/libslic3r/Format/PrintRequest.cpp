@@ -49,13 +49,14 @@ void read_tree(const boost::property_tree::ptree::value_type& section, boost::fi
 		}
 	}
 }
-bool fill_model(Model* model, const boost::filesystem::path& model_path, const std::string& material, const std::vector<std::string>& transformation_matrix)
+bool fill_model(Model* model, const boost::filesystem::path& model_path, const std::string& material, const std::vector<std::string>& transformation_matrix,
+	std::function<void(int)> progress_fn, std::function<void()> throw_on_cancel_fn)
 {
 	if (!boost::filesystem::exists(model_path))
 		throw Slic3r::RuntimeError("Failed reading PrintRequest file. Path doesn't exists. " + model_path.string());
 	if (!boost::algorithm::iends_with(model_path.string(), ".stl"))
 		throw Slic3r::RuntimeError("Failed reading PrintRequest file. Path is not stl file. " + model_path.string());
-	bool result = load_stl(model_path.string().c_str(), model);
+	bool result = load_stl(model_path.string().c_str(), model, nullptr, progress_fn, throw_on_cancel_fn);
 	if (!material.empty()) {
 		model->objects.back()->volumes.front()->set_material_id(material);
 	}
@@ -103,7 +104,7 @@ void add_instance(Model* model, const boost::filesystem::path& model_path, const
 
 }
 
-bool load_printRequest(const char* input_file, Model* model)
+bool load_printRequest(const char* input_file, Model* model, std::function<void(int)> progress_fn, std::function<void()> throw_on_cancel_fn)
 {
 	pt::ptree tree;
 	try
@@ -140,14 +141,15 @@ bool load_printRequest(const char* input_file, Model* model)
 				try
 				{
 					read_tree(section2, model_path, material, material_color, transformation_matrix);
-					result = result && fill_model(model, model_path, material, transformation_matrix);
+					result = result && fill_model(model, model_path, material, transformation_matrix, progress_fn, throw_on_cancel_fn);
 					if (!result)
 						return false;
 					add_instance(model, model_path, transformation_matrix);
 				}
-				catch (const std::exception& e)
+				catch (const std::exception&)
 				{
-					throw e;
+					// Rethrow the original exception, the cancellation of the STL import in particular.
+					throw;
 				}
 				
 				
@@ -1,11 +1,12 @@
 #ifndef slic3r_Format_PrintRequest_hpp_
 #define slic3r_Format_PrintRequest_hpp_
 
-
+#include <functional>
 
 namespace Slic3r {
 class Model;
-bool load_printRequest(const char* input_file, Model* model);
+// progress_fn and throw_on_cancel_fn are passed to load_stl() for each of the referenced STL files.
+bool load_printRequest(const char* input_file, Model* model, std::function<void(int)> progress_fn = nullptr, std::function<void()> throw_on_cancel_fn = nullptr);
 
 } //namespace Slic3r 
 
@@ -1,10 +1,25 @@
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/convert.hpp>
+#include <boost/predef/other/endian.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <ankerl/unordered_dense.h>
 #include <string>
 #include <utility>
 #include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "libslic3r/Model.hpp"
 #include "libslic3r/TriangleMesh.hpp"
 #include "STL.hpp"
+#include "admesh/stl.h"
 
 #ifdef _WIN32
 #define DIR_SEPARATOR '\\'
@@ -12,12 +27,239 @@
 #define DIR_SEPARATOR '/'
 #endif
 
+#if BOOST_ENDIAN_BIG_BYTE
+extern void stl_internal_reverse_quads(char *buf, size_t cnt);
+#endif /* BOOST_ENDIAN_BIG_BYTE */
+
 namespace Slic3r {
 
-bool load_stl(const char *path, Model *model, const char *object_name_in)
+// Binary STL files starting from this size are loaded by load_stl_binary_indexed(). Such files typically come from 3D scanners,
+// admesh would need several times more memory than the file size to load and repair them.
+static constexpr const size_t STL_INDEXED_MIN_FILE_SIZE = 256 * 1024 * 1024;
+
+namespace {
+
+// Vertex of an STL facet as its bit pattern with negative zeros turned to positive zeros, used to merge bit identical vertices.
+struct STLVertexKey
+{
+    uint32_t coords[3];
+    bool operator==(const STLVertexKey &rhs) const { return coords[0] == rhs.coords[0] && coords[1] == rhs.coords[1] && coords[2] == rhs.coords[2]; }
+};
+
+struct STLVertexKeyHash
+{
+    uint64_t operator()(const STLVertexKey &key) const {
+        uint64_t h = (uint64_t(key.coords[0]) * 0x9e3779b97f4a7c15ull) ^ (uint64_t(key.coords[1]) * 0xc2b2ae3d27d4eb4full) ^ (uint64_t(key.coords[2]) * 0x165667b19e3779f9ull);
+        return h ^ (h >> 29);
+    }
+};
+
+// Binary STL facet as stored in the file: normal, three vertices, attribute byte count, 50 bytes in total.
+class STLBinaryFacets
+{
+public:
+    STLBinaryFacets(const char *data, size_t num_facets) : m_data(data), m_num_facets(num_facets) {}
+
+    size_t      num_facets() const { return m_num_facets; }
+    stl_vertex  vertex(size_t facet_idx, int vertex_idx) const {
+        float coords[3];
+        memcpy(coords, m_data + facet_idx * SIZEOF_STL_FACET + (vertex_idx + 1) * 3 * sizeof(float), 3 * sizeof(float));
+#if BOOST_ENDIAN_BIG_BYTE
+        stl_internal_reverse_quads(reinterpret_cast<char*>(coords), 3 * sizeof(float));
+#endif /* BOOST_ENDIAN_BIG_BYTE */
+        return { coords[0], coords[1], coords[2] };
+    }
+    static STLVertexKey vertex_key(const stl_vertex &v) {
+        STLVertexKey key;
+        for (int i = 0; i < 3; ++ i) {
+            // -0.f + 0.f == +0.f
+            float c = v[i] + 0.f;
+            memcpy(&key.coords[i], &c, sizeof(float));
+        }
+        return key;
+    }
+
+private:
+    const char *m_data;
+    size_t      m_num_facets;
+};
+
+} // namespace
+
+bool load_stl_binary_indexed(const char *path, indexed_triangle_set &its, std::function<void(int)> progress_fn, std::function<void()> throw_on_cancel_fn)
+{
+    if (! progress_fn)
+        progress_fn = [](int) {};
+    if (! throw_on_cancel_fn)
+        throw_on_cancel_fn = []() {};
+
+    boost::iostreams::mapped_file_source file;
+    try {
+#ifdef _WIN32
+        file.open(boost::filesystem::path(boost::nowide::widen(path)));
+#else
+        file.open(std::string(path));
+#endif
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(error) << "load_stl_binary_indexed: Couldn't map " << path << ": " << ex.what();
+        return false;
+    }
+
+    // Detect a binary STL the same way as admesh does: Some of the first 128 bytes after the header have the highest bit set
+    // and the file size matches the facet size.
+    const size_t      file_size = file.size();
+    const char       *data      = file.data();
+    if (file_size < STL_MIN_FILE_SIZE || (file_size - HEADER_SIZE) % SIZEOF_STL_FACET != 0 ||
+        std::none_of(data + HEADER_SIZE, data + HEADER_SIZE + 128, [](char c) { return (unsigned char)c > 127; }))
+        return false;
+    const size_t      num_facets = (file_size - HEADER_SIZE) / SIZEOF_STL_FACET;
+    if (num_facets > size_t(std::numeric_limits<int>::max() / 3)) {
+        BOOST_LOG_TRIVIAL(error) << "load_stl_binary_indexed: Too many facets in " << path;
+        return false;
+    }
+    const STLBinaryFacets facets(data + HEADER_SIZE, num_facets);
+    const uint32_t        num_corners = uint32_t(3 * num_facets);
+    BOOST_LOG_TRIVIAL(debug) << "load_stl_binary_indexed: Loading " << num_facets << " facets from " << path;
+
+    // The corners are split into blocks of facets processed in parallel and into shards by the hash of their vertices,
+    // each shard is welded independently. Vertex ids are assigned in the order of the corners, thus the result does not depend
+    // on the number of threads.
+    static constexpr const size_t   facets_per_block = 65536;
+    static constexpr const uint32_t num_shards       = 256;
+    const size_t                    num_blocks       = (num_facets + facets_per_block - 1) / facets_per_block;
+    auto shard_of = [](const STLVertexKey &key) { return uint32_t(STLVertexKeyHash()(key) & (num_shards - 1)); };
+
+    // 1) Validate the coordinates and count the corners per block and shard.
+    std::vector<uint32_t> shard_offsets(num_blocks * num_shards, 0);
+    std::atomic<bool>     invalid_coordinate { false };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx) {
+            throw_on_cancel_fn();
+            uint32_t *counts = shard_offsets.data() + block_idx * num_shards;
+            for (size_t facet_idx = block_idx * facets_per_block; facet_idx < std::min(num_facets, (block_idx + 1) * facets_per_block); ++ facet_idx)
+                for (int j = 0; j < 3; ++ j) {
+                    stl_vertex v = facets.vertex(facet_idx, j);
+                    if (! std::isfinite(v.x()) || ! std::isfinite(v.y()) || ! std::isfinite(v.z()))
+                        invalid_coordinate = true;
+                    ++ counts[shard_of(STLBinaryFacets::vertex_key(v))];
+                }
+        }
+    });
+    if (invalid_coordinate) {
+        BOOST_LOG_TRIVIAL(error) << "load_stl_binary_indexed: " << path << " contains invalid coordinates";
+        return false;
+    }
+    progress_fn(20);
+
+    // 2) Turn the counts into offsets: Corners are sorted by shard, then by block, then by their index.
+    std::vector<uint32_t> shard_begin(num_shards + 1, 0);
+    {
+        uint32_t offset = 0;
+        for (uint32_t shard_idx = 0; shard_idx < num_shards; ++ shard_idx) {
+            shard_begin[shard_idx] = offset;
+            for (size_t block_idx = 0; block_idx < num_blocks; ++ block_idx) {
+                uint32_t &count = shard_offsets[block_idx * num_shards + shard_idx];
+                uint32_t  next  = offset + count;
+                count  = offset;
+                offset = next;
+            }
+        }
+        shard_begin[num_shards] = offset;
+        assert(offset == num_corners);
+    }
+
+    // 3) Scatter corner indices into shards.
+    std::vector<uint32_t> corners_by_shard(num_corners);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx) {
+            throw_on_cancel_fn();
+            uint32_t *offsets = shard_offsets.data() + block_idx * num_shards;
+            for (size_t facet_idx = block_idx * facets_per_block; facet_idx < std::min(num_facets, (block_idx + 1) * facets_per_block); ++ facet_idx)
+                for (int j = 0; j < 3; ++ j)
+                    corners_by_shard[offsets[shard_of(STLBinaryFacets::vertex_key(facets.vertex(facet_idx, j)))] ++] = uint32_t(3 * facet_idx + j);
+        }
+    });
+    shard_offsets = {};
+    progress_fn(40);
+
+    // 4) Weld each shard, map each corner to the first corner with the same vertex.
+    its.clear();
+    its.indices.assign(num_facets, stl_triangle_vertex_indices(0, 0, 0));
+    static_assert(sizeof(stl_triangle_vertex_indices) == 3 * sizeof(int), "stl_triangle_vertex_indices is expected to be tightly packed");
+    int *corner_data = its.indices.front().data();
+    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, num_shards, 1), [&](const tbb::blocked_range<uint32_t> &range) {
+        ankerl::unordered_dense::map<STLVertexKey, uint32_t, STLVertexKeyHash> first_corner;
+        for (uint32_t shard_idx = range.begin(); shard_idx < range.end(); ++ shard_idx) {
+            throw_on_cancel_fn();
+            first_corner.clear();
+            first_corner.reserve(shard_begin[shard_idx + 1] - shard_begin[shard_idx]);
+            for (uint32_t i = shard_begin[shard_idx]; i < shard_begin[shard_idx + 1]; ++ i) {
+                uint32_t corner = corners_by_shard[i];
+                corner_data[corner] = int(first_corner.try_emplace(STLBinaryFacets::vertex_key(facets.vertex(corner / 3, corner % 3)), corner).first->second);
+            }
+        }
+    });
+    progress_fn(70);
+
+    // 5) Number the first corners of each vertex in the order of the corners, reusing corners_by_shard for the corner to vertex map.
+    std::vector<uint32_t> &vertex_of_corner = corners_by_shard;
+    std::vector<uint32_t>  block_vertices(num_blocks + 1, 0);
+    auto for_each_corner_in_block = [num_facets](size_t block_idx, auto fn) {
+        for (uint32_t corner = uint32_t(3 * block_idx * facets_per_block); corner < uint32_t(3 * std::min(num_facets, (block_idx + 1) * facets_per_block)); ++ corner)
+            fn(corner);
+    };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx)
+            for_each_corner_in_block(block_idx, [&](uint32_t corner) {
+                if (corner_data[corner] == int(corner))
+                    ++ block_vertices[block_idx + 1];
+            });
+    });
+    for (size_t block_idx = 0; block_idx < num_blocks; ++ block_idx)
+        block_vertices[block_idx + 1] += block_vertices[block_idx];
+    its.vertices.assign(block_vertices.back(), stl_vertex::Zero());
+    throw_on_cancel_fn();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx) {
+            uint32_t vertex_idx = block_vertices[block_idx];
+            for_each_corner_in_block(block_idx, [&](uint32_t corner) {
+                if (corner_data[corner] == int(corner)) {
+                    vertex_of_corner[corner] = vertex_idx;
+                    its.vertices[vertex_idx ++] = facets.vertex(corner / 3, corner % 3);
+                }
+            });
+        }
+    });
+    progress_fn(85);
+
+    // 6) Replace the first corners by the vertex indices. The first corner of a vertex never follows the corner referencing it,
+    // thus its vertex index has been assigned already.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t block_idx = range.begin(); block_idx < range.end(); ++ block_idx)
+            for_each_corner_in_block(block_idx, [&](uint32_t corner) {
+                corner_data[corner] = int(vertex_of_corner[corner_data[corner]]);
+            });
+    });
+    progress_fn(100);
+
+    BOOST_LOG_TRIVIAL(debug) << "load_stl_binary_indexed: Loaded " << its.indices.size() << " facets, " << its.vertices.size() << " vertices";
+    return true;
+}
+
+bool load_stl(const char *path, Model *model, const char *object_name_in, std::function<void(int)> progress_fn, std::function<void()> throw_on_cancel_fn)
 {
     TriangleMesh mesh;
-    if (! mesh.ReadSTLFile(path)) {
+    boost::system::error_code ec;
+    if (indexed_triangle_set its; boost::filesystem::file_size(path, ec) >= STL_INDEXED_MIN_FILE_SIZE && ! ec &&
+        load_stl_binary_indexed(path, its, progress_fn, throw_on_cancel_fn)) {
+        // Only remove the degenerate facets, admesh repair would be too expensive.
+        RepairedMeshErrors errors;
+        errors.degenerate_facets = its_remove_degenerate_faces(its);
+        errors.facets_removed    = errors.degenerate_facets;
+        if (errors.degenerate_facets > 0)
+            its_compactify_vertices(its);
+        mesh = TriangleMesh(std::move(its), errors);
+    } else if (! mesh.ReadSTLFile(path)) {
 //    die "Failed to open $file\n" if !-e $path;
         return false;
     }
@@ -1,6 +1,10 @@
 #ifndef slic3r_Format_STL_hpp_
 #define slic3r_Format_STL_hpp_
 
+#include <functional>
+
+struct indexed_triangle_set;
+
 namespace Slic3r {
 
 class TriangleMesh;
@@ -8,7 +12,17 @@ class ModelObject;
 class Model;
 
 // Load an STL file into a provided model.
-extern bool load_stl(const char *path, Model *model, const char *object_name = nullptr);
+// Large binary STL files are loaded by load_stl_binary_indexed(), the rest by admesh including its repair.
+extern bool load_stl(const char *path, Model *model, const char *object_name = nullptr,
+    std::function<void(int)> progress_fn = nullptr, std::function<void()> throw_on_cancel_fn = nullptr);
+
+// Load a binary STL file by memory mapping it and decoding its facets directly into an indexed triangle set.
+// Bit identical vertices are merged in parallel, the vertices are numbered in the order of their first occurrence.
+// Contrary to admesh, the mesh is not repaired and the whole file is never copied into memory.
+// Returns false if the file could not be mapped, if it is not a binary STL file or if it contains invalid coordinates.
+// progress_fn is called with the percentage done, throw_on_cancel_fn is called regularly to possibly cancel the import.
+extern bool load_stl_binary_indexed(const char *path, indexed_triangle_set &its,
+    std::function<void(int)> progress_fn = nullptr, std::function<void()> throw_on_cancel_fn = nullptr);
 
 extern bool store_stl(const char *path, TriangleMesh *mesh, bool binary);
 extern bool store_stl(const char *path, ModelObject *model_object, bool binary);
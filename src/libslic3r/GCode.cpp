@@ -47,6 +47,7 @@
 #include "SVG.hpp"
 
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 // Intel redesigned some TBB interface considerably when merging TBB with their oneAPI set of libraries, see GH #7332.
 // We are using quite an old TBB 2017 U7. Before we update our build servers, let's use the old API, which is deprecated in up to date TBB.
@@ -559,7 +560,7 @@ GCodeGenerator::GCodeGenerator(const Print* print) :
     m_print(print)
     {}
 
-void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorResult* result, ThumbnailsGeneratorCallback thumbnail_cb)
+bool GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorResult* result, ThumbnailsGeneratorCallback thumbnail_cb, bool raw_in_temp_dir)
 {
     CNumericLocalesSetter locales_setter;
 
@@ -567,7 +568,7 @@ void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorRes
     {
         PrintStateBase::StateWithTimeStamp state = print->step_state_with_timestamp(psGCodeExport);
         if (! state.enabled || (state.is_done() && boost::filesystem::exists(boost::filesystem::path(path))))
-            return;
+            return true;
     }
 
     // Enabled and either not done, or marked as done while the output file is missing.
@@ -595,10 +596,29 @@ void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorRes
     std::string path_tmp(path);
     path_tmp += ".tmp";
 
-    m_processor.initialize(path_tmp);
+    // The G-code is generated into a local temporary file first and the post-processor streams it into path_tmp,
+    // so that the destination (possibly a network storage) is written just once.
+    // If the local temporary file could not be created, the G-code is generated into path_tmp and post processed in place.
+    std::string path_raw = path_tmp;
+    FILE       *file_raw = nullptr;
+    if (raw_in_temp_dir) {
+        path_raw = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.gcode.raw")).string();
+        file_raw = boost::nowide::fopen(path_raw.c_str(), "wb");
+        if (file_raw == nullptr)
+            path_raw = path_tmp;
+    }
+    if (file_raw == nullptr)
+        file_raw = boost::nowide::fopen(path_raw.c_str(), "wb");
+
+    m_processor.initialize(path_tmp, path_raw == path_tmp ? std::string() : path_raw);
     m_processor.set_print(print);
+    if (result != nullptr)
+        // Replay the time estimator's planner checkpoints recorded by the previous export into the same result.
+        m_processor.set_planner_checkpoints(std::move(result->planner_checkpoints));
+    // Without a result to be previewed only the print statistics are needed.
+    m_processor.enable_statistics_only(result == nullptr);
     m_processor.get_binary_data() = bgcode::binarize::BinaryData();
-    GCodeOutputStream file(boost::nowide::fopen(path_tmp.c_str(), "wb"), m_processor);
+    GCodeOutputStream file(file_raw, m_processor);
     if (! file.is_open())
         throw Slic3r::RuntimeError(std::string("G-code export to ") + path + " failed.\nCannot open the file for writing.\n");
 
@@ -607,26 +627,42 @@ void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorRes
         file.flush();
         if (file.is_error()) {
             file.close();
-            boost::nowide::remove(path_tmp.c_str());
+            boost::nowide::remove(path_raw.c_str());
+            if (path_raw != path_tmp) {
+                // The local temporary directory is likely full, let the caller export next to the destination.
+                BOOST_LOG_TRIVIAL(warning) << "Writing the G-code into " << path_raw << " failed, the G-code will be generated next to " << path;
+                return false;
+            }
             throw Slic3r::RuntimeError(std::string("G-code export to ") + path + " failed\nIs the disk full?\n");
         }
     } catch (std::exception & /* ex */) {
         // Rethrow on any exception. std::runtime_exception and CanceledException are expected to be thrown.
         // Close and remove the file.
         file.close();
-        boost::nowide::remove(path_tmp.c_str());
+        boost::nowide::remove(path_raw.c_str());
         throw;
     }
     file.close();
 
     if (! m_placeholder_parser_integration.failed_templates.empty()) {
         // G-code export proceeded, but some of the PlaceholderParser substitutions failed.
+        // The full error reports are stored in the raw G-code only. Keep it next to the destination, where the user will find it.
+        std::string path_errors = path_raw;
+        if (path_raw != path_tmp) {
+            if (! rename_file(path_raw, path_tmp))
+                path_errors = path_tmp;
+            else if (std::string error_message; copy_file(path_raw, path_tmp, error_message) == SUCCESS) {
+                // The temporary directory is on another file system.
+                boost::nowide::remove(path_raw.c_str());
+                path_errors = path_tmp;
+            }
+        }
         //FIXME localize!
         std::string msg = std::string("G-code export to ") + path + " failed due to invalid custom G-code sections:\n\n";
         for (const auto &name_and_error : m_placeholder_parser_integration.failed_templates)
             msg += name_and_error.first + "\n" + name_and_error.second + "\n";
         msg += "\nPlease inspect the file ";
-        msg += path_tmp + " for error messages enclosed between\n";
+        msg += path_errors + " for error messages enclosed between\n";
         msg += "        !!!!! Failed to process the custom G-code template ...\n";
         msg += "and\n";
         msg += "        !!!!! End of an error report for the custom G-code template ...\n";
@@ -636,7 +672,15 @@ void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorRes
 
     BOOST_LOG_TRIVIAL(debug) << "Start processing gcode, " << log_memory_info();
     // Post-process the G-code to update time stamps.
-    m_processor.finalize(true);
+    try {
+        m_processor.finalize(true);
+    } catch (std::exception & /* ex */) {
+        // Remove the raw G-code and the partially post processed G-code.
+        boost::nowide::remove(path_raw.c_str());
+        if (path_raw != path_tmp)
+            boost::nowide::remove(path_tmp.c_str());
+        throw;
+    }
 //    DoExport::update_print_estimated_times_stats(m_processor, print->m_print_statistics);
     DoExport::update_print_estimated_stats(m_processor, m_writer.extruders(), print->m_print_statistics);
     if (result != nullptr) {
@@ -653,6 +697,7 @@ void GCodeGenerator::do_export(Print* print, const char* path, GCodeProcessorRes
 
     BOOST_LOG_TRIVIAL(info) << "Exporting G-code finished" << log_memory_info();
     print->set_done(psGCodeExport);
+    return true;
 }
 
 // free functions called by GCodeGenerator::_do_export()
@@ -877,8 +922,8 @@ static inline GCode::SmoothPathCache smooth_path_interpolate_global(const Print&
 {
     const GCode::SmoothPathCache::InterpolationParameters interpolation_params = interpolation_parameters(print.config());
     GCode::SmoothPathCache out;
-    out.interpolate_add(print.skirt(), interpolation_params);
-    out.interpolate_add(print.brim(), interpolation_params);
+    const ExtrusionEntityCollection *collections[] { &print.skirt(), &print.brim() };
+    out.interpolate_add(collections, interpolation_params);
     return out;
 }
 
@@ -1547,14 +1592,23 @@ void GCodeGenerator::smooth_path_interpolate(
     const GCode::SmoothPathCache::InterpolationParameters   &params, 
     GCode::SmoothPathCache                                  &out)
 {
+    std::vector<const ExtrusionEntityCollection*> collections;
     if (const Layer *layer = object_layer_to_print.object_layer; layer) {
         for (const LayerRegion *layerm : layer->regions()) {
-            out.interpolate_add(layerm->perimeters(), params);
-            out.interpolate_add(layerm->fills(), params);
+            collections.emplace_back(&layerm->perimeters());
+            collections.emplace_back(&layerm->fills());
         }
     }
     if (const SupportLayer *layer = object_layer_to_print.support_layer; layer)
-        out.interpolate_add(layer->support_fills, params);
+        collections.emplace_back(&layer->support_fills);
+    out.interpolate_add(collections, params);
+}
+
+// Number of layers in flight in the process_layers() pipeline: Enough to keep all threads busy
+// interpolating smooth paths in parallel, while the serial stages process the preceding layers.
+static size_t process_layers_max_tokens()
+{
+    return std::max<size_t>(12, 2 * size_t(tbb::this_task_arena::max_concurrency()));
 }
 
 // Process all layers of all objects (non-sequential mode) with a parallel pipeline:
@@ -1570,25 +1624,27 @@ void GCodeGenerator::process_layers(
 {
     size_t layer_to_print_idx = 0;
     const GCode::SmoothPathCache::InterpolationParameters interpolation_params = interpolation_parameters(print.config());
-    const auto smooth_path_interpolator = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>>(slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &layers_to_print, &layer_to_print_idx, &interpolation_params](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache> {
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
-                    fc.stop();
-                    return {};
-                } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    return { layer_to_print_idx ++, {} };
-                }
-            } else {
-                print.throw_if_canceled();
-                size_t idx = layer_to_print_idx ++;
-                GCode::SmoothPathCache smooth_path_cache;
+    const auto layer_source = tbb::make_filter<void, size_t>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &layers_to_print, &layer_to_print_idx](tbb::flow_control &fc) -> size_t {
+            // Pressure equalizer need insert empty input. Because it returns one layer back.
+            // Insert NOP (no operation) layer with index layers_to_print.size();
+            if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
+                fc.stop();
+                return {};
+            }
+            print.throw_if_canceled();
+            return layer_to_print_idx ++;
+        });
+    // Interpolation of the extrusions by smooth paths (arc fitting) only reads the layers, therefore it is the one stage
+    // running in parallel. The following stages depend on the state of GCodeGenerator left by the previous layer
+    // (last position, active extruder, retraction, wipe), thus they run serially in the order of layers.
+    const auto smooth_path_interpolator = tbb::make_filter<size_t, std::pair<size_t, GCode::SmoothPathCache>>(slic3r_tbb_filtermode::parallel,
+        [&layers_to_print, &interpolation_params](size_t idx) -> std::pair<size_t, GCode::SmoothPathCache> {
+            GCode::SmoothPathCache smooth_path_cache;
+            if (idx < layers_to_print.size())
                 for (const ObjectLayerToPrint &l : layers_to_print[idx].second)
                     GCodeGenerator::smooth_path_interpolate(l, interpolation_params, smooth_path_cache);
-                return { idx, std::move(smooth_path_cache) };
-            }
+            return { idx, std::move(smooth_path_cache) };
         });
     const auto generator = tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
         [this, &print, &tool_ordering, &print_object_instances_ordering, &layers_to_print, &smooth_path_cache_global](
@@ -1637,7 +1693,7 @@ void GCodeGenerator::process_layers(
         [&output_stream](std::string s) { output_stream.write(s); }
     );
 
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = layer_source & smooth_path_interpolator & generator;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
@@ -1652,7 +1708,7 @@ void GCodeGenerator::process_layers(
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    tbb::parallel_pipeline(process_layers_max_tokens(), pipeline_to_layerresult & pipeline_to_string & output);
     output_stream.find_replace_enable();
 }
 
@@ -1669,24 +1725,25 @@ void GCodeGenerator::process_layers(
 {
     size_t layer_to_print_idx = 0;
     const GCode::SmoothPathCache::InterpolationParameters interpolation_params = interpolation_parameters(print.config());
-    const auto smooth_path_interpolator = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>> (slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &layers_to_print, &layer_to_print_idx, interpolation_params](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache> {
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
-                    fc.stop();
-                    return {};
-                } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    return { layer_to_print_idx ++, {} };
-                }
-            } else {
-                print.throw_if_canceled();
-                size_t idx = layer_to_print_idx ++;
-                GCode::SmoothPathCache smooth_path_cache;
-                GCodeGenerator::smooth_path_interpolate(layers_to_print[idx], interpolation_params, smooth_path_cache);
-                return { idx, std::move(smooth_path_cache) };
+    const auto layer_source = tbb::make_filter<void, size_t>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &layers_to_print, &layer_to_print_idx](tbb::flow_control &fc) -> size_t {
+            // Pressure equalizer need insert empty input. Because it returns one layer back.
+            // Insert NOP (no operation) layer with index layers_to_print.size();
+            if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
+                fc.stop();
+                return {};
             }
+            print.throw_if_canceled();
+            return layer_to_print_idx ++;
+        });
+    // Runs in parallel, see the other process_layers(). The generator moves the ObjectLayerToPrint out of layers_to_print,
+    // which is safe as the generator receives a layer only after its smooth paths were interpolated.
+    const auto smooth_path_interpolator = tbb::make_filter<size_t, std::pair<size_t, GCode::SmoothPathCache>>(slic3r_tbb_filtermode::parallel,
+        [&layers_to_print, &interpolation_params](size_t idx) -> std::pair<size_t, GCode::SmoothPathCache> {
+            GCode::SmoothPathCache smooth_path_cache;
+            if (idx < layers_to_print.size())
+                GCodeGenerator::smooth_path_interpolate(layers_to_print[idx], interpolation_params, smooth_path_cache);
+            return { idx, std::move(smooth_path_cache) };
         });
     const auto generator = tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
         [this, &print, &tool_ordering, &layers_to_print, &smooth_path_cache_global, single_object_idx](std::pair<size_t, GCode::SmoothPathCache> in) -> LayerResult {
@@ -1730,7 +1787,7 @@ void GCodeGenerator::process_layers(
         [&output_stream](std::string s) { output_stream.write(s); }
     );
 
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = layer_source & smooth_path_interpolator & generator;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
@@ -1745,7 +1802,7 @@ void GCodeGenerator::process_layers(
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    tbb::parallel_pipeline(process_layers_max_tokens(), pipeline_to_layerresult & pipeline_to_string & output);
     output_stream.find_replace_enable();
 }
 
@@ -3279,17 +3336,25 @@ void GCodeGenerator::GCodeOutputStream::close()
     }
 }
 
-void GCodeGenerator::GCodeOutputStream::write(const char *what)
+void GCodeGenerator::GCodeOutputStream::write(const std::string &what)
 {
-    if (what != nullptr) {
-        //FIXME don't allocate a string, maybe process a batch of lines?
-        std::string gcode(m_find_replace ? m_find_replace->process_layer(what) : what);
-        // writes string to file
-        fwrite(gcode.c_str(), 1, gcode.size(), this->f);
+    if (m_find_replace) {
+        std::string gcode = m_find_replace->process_layer(what);
+        fwrite(gcode.data(), 1, gcode.size(), this->f);
         m_processor.process_buffer(gcode);
+    } else {
+        // Layers produced by process_layers() are written and analyzed without copying.
+        fwrite(what.data(), 1, what.size(), this->f);
+        m_processor.process_buffer(what);
     }
 }
 
+void GCodeGenerator::GCodeOutputStream::write(const char *what)
+{
+    if (what != nullptr)
+        this->write(std::string(what));
+}
+
 void GCodeGenerator::GCodeOutputStream::writeln(const std::string &what)
 {
     if (! what.empty())
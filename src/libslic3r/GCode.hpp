@@ -98,7 +98,11 @@ public:
 
     // throws std::runtime_exception on error,
     // throws CanceledException through print->throw_if_canceled().
-    void            do_export(Print* print, const char* path, GCodeProcessorResult* result = nullptr, ThumbnailsGeneratorCallback thumbnail_cb = nullptr);
+    // If raw_in_temp_dir is set, the G-code is generated into the local temporary directory before being post processed into path.
+    // Returns false if writing into the temporary directory failed (for example it is full), in which case nothing was exported
+    // and the export is to be repeated by a new GCodeGenerator with raw_in_temp_dir = false.
+    bool            do_export(Print* print, const char* path, GCodeProcessorResult* result = nullptr, ThumbnailsGeneratorCallback thumbnail_cb = nullptr,
+                        bool raw_in_temp_dir = true);
 
     // Exported for the helper classes (OozePrevention, Wipe) and for the Perl binding for unit tests.
     const Vec2d&    origin() const { return m_origin; }
@@ -182,7 +186,7 @@ private:
         void close();
 
         // Write a string into a file.
-        void write(const std::string& what) { this->write(what.c_str()); }
+        void write(const std::string& what);
         void write(const char* what);
 
         // Write a string into a file. 
@@ -334,9 +334,10 @@ finished:
 
 std::string CoolingBuffer::process_layer(std::string &&gcode, size_t layer_id, bool flush)
 {
-    // Cache the input G-code.
+    // Cache the input G-code. Either the input string or the storage of the cache left by the previous layer
+    // is then recycled for the output, so that the multi megabyte layer strings are not reallocated.
     if (m_gcode.empty())
-        m_gcode = std::move(gcode);
+        m_gcode.swap(gcode);
     else
         m_gcode += gcode;
 
@@ -346,7 +347,9 @@ std::string CoolingBuffer::process_layer(std::string &&gcode, size_t layer_id, b
         // and one object layer.
         std::vector<PerExtruderAdjustments> per_extruder_adjustments = this->parse_layer_gcode(m_gcode, m_current_pos);
         float layer_time_stretched = this->calculate_layer_slowdown(per_extruder_adjustments);
-        out = this->apply_layer_cooldown(m_gcode, layer_id, layer_time_stretched, per_extruder_adjustments);
+        out.swap(gcode);
+        out.clear();
+        this->apply_layer_cooldown(m_gcode, layer_id, layer_time_stretched, per_extruder_adjustments, out);
         m_gcode.clear();
     }
     return out;
@@ -798,7 +801,7 @@ float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments
 
 // Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
 // Returns the adjusted G-code.
-std::string CoolingBuffer::apply_layer_cooldown(
+void CoolingBuffer::apply_layer_cooldown(
     // Source G-code for the current layer.
     const std::string                      &gcode,
     // ID of the current layer, used to disable fan for the first n layers.
@@ -806,7 +809,9 @@ std::string CoolingBuffer::apply_layer_cooldown(
     // Total time of this layer after slow down, used to control the fan.
     float                                   layer_time,
     // Per extruder list of G-code lines and their cool down attributes.
-    std::vector<PerExtruderAdjustments>    &per_extruder_adjustments)
+    std::vector<PerExtruderAdjustments>    &per_extruder_adjustments,
+    // Output: The adjusted G-code is appended here.
+    std::string                            &new_gcode)
 {
     // First sort the adjustment lines by of multiple extruders by their position in the source G-code.
     std::vector<const CoolingLine*> lines;
@@ -820,9 +825,8 @@ std::string CoolingBuffer::apply_layer_cooldown(
                 lines.emplace_back(&line);
         std::sort(lines.begin(), lines.end(), [](const CoolingLine *ln1, const CoolingLine *ln2) { return ln1->line_start < ln2->line_start; } );
     }
-    // Second generate the adjusted G-code.
-    std::string new_gcode;
-    new_gcode.reserve(gcode.size() * 2);
+    // Second generate the adjusted G-code. Only a few lines are added or extended by the slow down and fan control.
+    new_gcode.reserve(new_gcode.size() + gcode.size() + gcode.size() / 8);
     bool bridge_fan_control = false;
     int  bridge_fan_speed   = 0;
     auto change_extruder_set_fan = [this, layer_id, layer_time, &new_gcode, &bridge_fan_control, &bridge_fan_speed](const int requested_fan_speed = -1) {
@@ -1043,7 +1047,6 @@ std::string CoolingBuffer::apply_layer_cooldown(
 
     // There should be no empty G1 lines emitted.
     assert(new_gcode.find("G1\n") == std::string::npos);
-    return new_gcode;
 }
 
 } // namespace Slic3r
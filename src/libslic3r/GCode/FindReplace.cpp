@@ -114,28 +114,21 @@ static void find_and_replace_whole_word(std::string &inout, const std::string &m
     }
 }
 
-std::string GCodeFindReplace::process_layer(const std::string &ain)
+std::string GCodeFindReplace::process_layer(std::string gcode)
 {
-    std::string out;
-    const std::string *in = &ain;
-    std::string temp;
-    temp.reserve(in->size());
-
     for (const Substitution &substitution : m_substitutions) {
         if (substitution.regexp) {
-            temp.clear();
-            temp.reserve(in->size());
-            boost::regex_replace(ToStringIterator(temp), in->begin(), in->end(),
+            m_temp.clear();
+            m_temp.reserve(gcode.size());
+            boost::regex_replace(ToStringIterator(m_temp), gcode.begin(), gcode.end(),
                 substitution.regexp_pattern, substitution.format, 
                 (substitution.single_line ? boost::match_single_line | boost::match_default : boost::match_not_dot_newline | boost::match_default) | boost::format_all);
-            std::swap(out, temp);
+            gcode.swap(m_temp);
         } else {
-            if (in == &ain)
-                out = ain;
             // Plain substitution
             if (substitution.case_insensitive) {
                 if (substitution.whole_word)
-                    find_and_replace_whole_word(out, substitution.plain_pattern, substitution.format,
+                    find_and_replace_whole_word(gcode, substitution.plain_pattern, substitution.format,
                         [](const std::string &str, size_t start_pos, const std::string &match) {
                             auto begin = str.begin() + start_pos;
                             boost::iterator_range<std::string::const_iterator> r1(begin, str.end());
@@ -144,22 +137,21 @@ std::string GCodeFindReplace::process_layer(const std::string &ain)
                             return res ? std::make_pair(size_t(res.begin() - str.begin()), size_t(res.end() - str.begin())) : std::make_pair(std::string::npos, std::string::npos);
                         });
                 else
-                    boost::ireplace_all(out, substitution.plain_pattern, substitution.format);
+                    boost::ireplace_all(gcode, substitution.plain_pattern, substitution.format);
             } else {
                 if (substitution.whole_word)
-                    find_and_replace_whole_word(out, substitution.plain_pattern, substitution.format,
+                    find_and_replace_whole_word(gcode, substitution.plain_pattern, substitution.format,
                         [](const std::string &str, size_t start_pos, const std::string &match) { 
                             size_t pos = str.find(match, start_pos);
                             return std::make_pair(pos, pos + (pos == std::string::npos ? 0 : match.size()));
                         });
                 else
-                    boost::replace_all(out, substitution.plain_pattern, substitution.format);
+                    boost::replace_all(gcode, substitution.plain_pattern, substitution.format);
             }
         }
-        in = &out;
     }
 
-    return out;
+    return gcode;
 }
 
 }
@@ -16,7 +16,8 @@ public:
     GCodeFindReplace(const std::vector<std::string> &gcode_substitutions);
 
 
-    std::string process_layer(const std::string &gcode);
+    // The G-code is taken by value: A layer moved in is modified in place by the plain substitutions.
+    std::string process_layer(std::string gcode);
     
 private:
     struct Substitution {
@@ -31,6 +32,8 @@ private:
         bool            single_line { false };
     };
     std::vector<Substitution> m_substitutions;
+    // Output of the regular expression substitutions, swapped with the processed G-code to recycle its storage.
+    std::string               m_temp;
 };
 
 }
@@ -6,9 +6,11 @@
 #include "libslic3r/GCode/GCodeWriter.hpp"
 #include "libslic3r/I18N.hpp"
 #include "libslic3r/Geometry/ArcWelder.hpp"
+#include "libslic3r/Thread.hpp"
 #include "GCodeProcessor.hpp"
 
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -25,6 +27,10 @@
 #endif
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 static const float DEFAULT_TOOLPATH_WIDTH = 0.4f;
 static const float DEFAULT_TOOLPATH_HEIGHT = 0.2f;
@@ -195,6 +201,10 @@ void GCodeProcessor::TimeMachine::reset()
     blocks = std::vector<TimeBlock>();
     g1_times_cache = std::vector<G1LinesCacheItem>();
     first_layer_time = 0.0f;
+    layers_time = std::vector<float>();
+    planned_blocks = 0;
+    replayed_checkpoints = nullptr;
+    replayed_checkpoints_count = 0;
 }
 
 static void planner_forward_pass_kernel(const GCodeProcessor::TimeBlock& prev, GCodeProcessor::TimeBlock& curr)
@@ -287,18 +297,79 @@ void GCodeProcessor::TimeMachine::calculate_time(GCodeProcessorResult& result, P
 
     assert(keep_last_n_blocks <= blocks.size());
 
-    // reverse_pass
-    for (int i = static_cast<int>(blocks.size()) - 1; i > 0; --i) {
-        planner_reverse_pass_kernel(blocks[i - 1], blocks[i]);
+    const bool record_checkpoint = result.planner_checkpoints.enabled;
+    size_t     input_hash        = 0;
+    if (record_checkpoint || replayed_checkpoints != nullptr) {
+        // Only the blocks entering the queue since the last call are hashed: While the previous checkpoints matched,
+        // the blocks planned already are the same as in the recorded run.
+        boost::hash_combine(input_hash, blocks.size() - planned_blocks);
+        for (size_t i = planned_blocks; i < blocks.size(); ++i) {
+            const TimeBlock& block = blocks[i];
+            for (float v : { block.distance, block.acceleration, block.max_entry_speed, block.safe_feedrate,
+                             block.feedrate_profile.entry, block.feedrate_profile.cruise, block.feedrate_profile.exit,
+                             block.trapezoid.accelerate_until, block.trapezoid.decelerate_after, block.trapezoid.cruise_feedrate })
+                boost::hash_combine(input_hash, v);
+            boost::hash_combine(input_hash, int(block.flags.recalculate) | (int(block.flags.nominal_length) << 1));
+        }
     }
 
-    // forward_pass
-    for (size_t i = 0; i + 1 < blocks.size(); ++i) {
-        planner_forward_pass_kernel(blocks[i], blocks[i + 1]);
+    const GCodeProcessorResult::PlannerCheckpoint* replayed_checkpoint = nullptr;
+    if (replayed_checkpoints != nullptr) {
+        if (replayed_checkpoints_count < replayed_checkpoints->size() &&
+            (*replayed_checkpoints)[replayed_checkpoints_count].input_hash == input_hash &&
+            (*replayed_checkpoints)[replayed_checkpoints_count].layer_id == blocks.back().layer_id &&
+            (*replayed_checkpoints)[replayed_checkpoints_count].blocks.size() == blocks.size()) {
+            replayed_checkpoint = &(*replayed_checkpoints)[replayed_checkpoints_count ++];
+            ++ result.planner_checkpoints.num_replayed;
+        } else {
+            BOOST_LOG_TRIVIAL(debug) << "Time estimate, " << (mode == PrintEstimatedStatistics::ETimeMode::Normal ? "normal" : "stealth") <<
+                " mode: Replayed " << replayed_checkpoints_count << " planner checkpoints, planning from layer " << blocks.back().layer_id;
+            replayed_checkpoints = nullptr;
+        }
     }
 
-    recalculate_trapezoids(blocks);
+    if (replayed_checkpoint != nullptr) {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            TimeBlock& block = blocks[i];
+            const std::array<float, 5>& planned = replayed_checkpoint->blocks[i];
+            block.feedrate_profile.entry = planned[0];
+            block.feedrate_profile.exit = planned[1];
+            block.trapezoid.accelerate_until = planned[2];
+            block.trapezoid.decelerate_after = planned[3];
+            block.trapezoid.cruise_feedrate = planned[4];
+            block.flags.recalculate = false;
+        }
+    } else {
+        // reverse_pass
+        for (int i = static_cast<int>(blocks.size()) - 1; i > 0; --i) {
+            planner_reverse_pass_kernel(blocks[i - 1], blocks[i]);
+        }
+
+        // forward_pass
+        for (size_t i = 0; i + 1 < blocks.size(); ++i) {
+            planner_forward_pass_kernel(blocks[i], blocks[i + 1]);
+        }
+
+        recalculate_trapezoids(blocks);
+    }
+
+    if (record_checkpoint) {
+        std::vector<GCodeProcessorResult::PlannerCheckpoint>& checkpoints = result.planner_checkpoints.machines[static_cast<size_t>(mode)];
+        if (replayed_checkpoint != nullptr)
+            checkpoints.emplace_back(*replayed_checkpoint);
+        else {
+            GCodeProcessorResult::PlannerCheckpoint& checkpoint = checkpoints.emplace_back();
+            checkpoint.input_hash = input_hash;
+            checkpoint.layer_id = blocks.back().layer_id;
+            checkpoint.blocks.reserve(blocks.size());
+            for (const TimeBlock& block : blocks)
+                checkpoint.blocks.push_back({ block.feedrate_profile.entry, block.feedrate_profile.exit,
+                    block.trapezoid.accelerate_until, block.trapezoid.decelerate_after, block.trapezoid.cruise_feedrate });
+        }
+    }
 
+    // No moves are stored in the statistics only mode, see GCodeProcessor::enable_statistics_only().
+    const bool store_moves = ! result.moves.empty();
     const size_t n_blocks_process = blocks.size() - keep_last_n_blocks;
     for (size_t i = 0; i < n_blocks_process; ++i) {
         const TimeBlock& block = blocks[i];
@@ -307,26 +378,30 @@ void GCodeProcessor::TimeMachine::calculate_time(GCodeProcessorResult& result, P
             block_time += additional_time;
 
         time += double(block_time);
-        result.moves[block.move_id].time[static_cast<size_t>(mode)] = block_time;
+        if (store_moves)
+            result.moves.time(block.move_id)[static_cast<size_t>(mode)] = block_time;
         gcode_time.cache += block_time;
         if (block.layer_id == 1)
             first_layer_time += block_time;
+        if (layers_time.size() < block.layer_id)
+            layers_time.resize(block.layer_id, 0.0f);
+        layers_time[block.layer_id - 1] += block_time;
 
         // detect actual speed moves required to render toolpaths using actual speed
-        if (mode == PrintEstimatedStatistics::ETimeMode::Normal) {
-            GCodeProcessorResult::MoveVertex& curr_move = result.moves[block.move_id];
+        if (store_moves && mode == PrintEstimatedStatistics::ETimeMode::Normal) {
+            const GCodeProcessorResult::MoveVertex curr_move = result.moves[block.move_id];
             if (curr_move.type == EMoveType::Extrude ||
                 curr_move.type == EMoveType::Travel ||
                 curr_move.type == EMoveType::Wipe) {
                 assert(curr_move.actual_feedrate == 0.0f);
 
-                GCodeProcessorResult::MoveVertex& prev_move = result.moves[block.move_id - 1];
+                const GCodeProcessorResult::MoveVertex prev_move = result.moves[block.move_id - 1];
                 const bool interpolate = (prev_move.type == curr_move.type);
                 if (!interpolate &&
                     prev_move.type != EMoveType::Extrude &&
                     prev_move.type != EMoveType::Travel &&
                     prev_move.type != EMoveType::Wipe)
-                    prev_move.actual_feedrate = block.feedrate_profile.entry;
+                    result.moves.actual_feedrate(block.move_id - 1) = block.feedrate_profile.entry;
 
                 if (EPSILON < block.trapezoid.accelerate_until && block.trapezoid.accelerate_until < block.distance - EPSILON) {
                     const float t = block.trapezoid.accelerate_until / block.distance;
@@ -420,6 +495,7 @@ void GCodeProcessor::TimeMachine::calculate_time(GCodeProcessorResult& result, P
     } else {
         blocks.clear();
     }
+    planned_blocks = blocks.size();
 }
 
 void GCodeProcessor::TimeProcessor::reset()
@@ -516,6 +592,193 @@ void GCodeProcessor::UsedFilaments::process_caches(const GCodeProcessor* process
     process_role_cache(processor);
 }
 
+GCodeProcessorResult::Moves::Attributes::Attributes(const MoveVertex& move)
+    : type(move.type)
+    , extrusion_role(move.extrusion_role)
+    , extruder_id(move.extruder_id)
+    , cp_color_id(move.cp_color_id)
+    , internal_only(move.internal_only)
+    , feedrate(move.feedrate)
+    , height(move.height)
+    , fan_speed(move.fan_speed)
+    , temperature(move.temperature)
+    , layer_id(move.layer_id)
+{}
+
+bool GCodeProcessorResult::Moves::Attributes::operator==(const Attributes& rhs) const
+{
+    return type == rhs.type && extrusion_role == rhs.extrusion_role && extruder_id == rhs.extruder_id && cp_color_id == rhs.cp_color_id &&
+        internal_only == rhs.internal_only && feedrate == rhs.feedrate && height == rhs.height && fan_speed == rhs.fan_speed && temperature == rhs.temperature && layer_id == rhs.layer_id;
+}
+
+size_t GCodeProcessorResult::Moves::AttributesHash::operator()(const Attributes& attributes) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, static_cast<unsigned char>(attributes.type));
+    boost::hash_combine(seed, static_cast<unsigned char>(attributes.extrusion_role));
+    boost::hash_combine(seed, attributes.extruder_id);
+    boost::hash_combine(seed, attributes.cp_color_id);
+    boost::hash_combine(seed, attributes.internal_only);
+    boost::hash_combine(seed, attributes.feedrate);
+    boost::hash_combine(seed, attributes.height);
+    boost::hash_combine(seed, attributes.fan_speed);
+    boost::hash_combine(seed, attributes.temperature);
+    boost::hash_combine(seed, attributes.layer_id);
+    return seed;
+}
+
+void GCodeProcessorResult::Moves::clear()
+{
+    m_gcode_ids.clear();
+    m_positions.clear();
+    m_delta_extruders.clear();
+    m_actual_feedrates.clear();
+    m_times.clear();
+    m_widths.clear();
+    m_mm3_per_mms.clear();
+    m_attributes_ids.clear();
+    m_attributes.clear();
+    m_attributes_lookup.clear();
+}
+
+void GCodeProcessorResult::Moves::reserve(size_t n)
+{
+    m_gcode_ids.reserve(n);
+    m_positions.reserve(n);
+    m_delta_extruders.reserve(n);
+    m_actual_feedrates.reserve(n);
+    m_times.reserve(n);
+    m_widths.reserve(n);
+    m_mm3_per_mms.reserve(n);
+    m_attributes_ids.reserve(n);
+}
+
+void GCodeProcessorResult::Moves::shrink_to_fit()
+{
+    m_gcode_ids.shrink_to_fit();
+    m_positions.shrink_to_fit();
+    m_delta_extruders.shrink_to_fit();
+    m_actual_feedrates.shrink_to_fit();
+    m_times.shrink_to_fit();
+    m_widths.shrink_to_fit();
+    m_mm3_per_mms.shrink_to_fit();
+    m_attributes_ids.shrink_to_fit();
+    m_attributes.shrink_to_fit();
+}
+
+void GCodeProcessorResult::Moves::resize(size_t n)
+{
+    const MoveVertex default_move;
+    const unsigned int attributes_id = n > size() ? store_attributes(default_move, 0) : 0;
+    m_gcode_ids.resize(n, default_move.gcode_id);
+    m_positions.resize(n, default_move.position);
+    m_delta_extruders.resize(n, default_move.delta_extruder);
+    m_actual_feedrates.resize(n, default_move.actual_feedrate);
+    m_times.resize(n, default_move.time);
+    m_widths.resize(n, default_move.width);
+    m_mm3_per_mms.resize(n, default_move.mm3_per_mm);
+    m_attributes_ids.resize(n, attributes_id);
+}
+
+void GCodeProcessorResult::Moves::push_back(const MoveVertex& move)
+{
+    const unsigned int attributes_id = store_attributes(move, m_attributes_ids.empty() ? 0 : m_attributes_ids.back());
+    m_gcode_ids.emplace_back(move.gcode_id);
+    m_positions.emplace_back(move.position);
+    m_delta_extruders.emplace_back(move.delta_extruder);
+    m_actual_feedrates.emplace_back(move.actual_feedrate);
+    m_times.emplace_back(move.time);
+    m_widths.emplace_back(move.width);
+    m_mm3_per_mms.emplace_back(move.mm3_per_mm);
+    m_attributes_ids.emplace_back(attributes_id);
+}
+
+GCodeProcessorResult::MoveVertex GCodeProcessorResult::Moves::operator[](size_t id) const
+{
+    assert(id < size());
+    const Attributes& attributes = m_attributes[m_attributes_ids[id]];
+    MoveVertex out;
+    out.gcode_id        = m_gcode_ids[id];
+    out.type            = attributes.type;
+    out.extrusion_role  = attributes.extrusion_role;
+    out.extruder_id     = attributes.extruder_id;
+    out.cp_color_id     = attributes.cp_color_id;
+    out.position        = m_positions[id];
+    out.delta_extruder  = m_delta_extruders[id];
+    out.feedrate        = attributes.feedrate;
+    out.actual_feedrate = m_actual_feedrates[id];
+    out.width           = m_widths[id];
+    out.height          = attributes.height;
+    out.mm3_per_mm      = m_mm3_per_mms[id];
+    out.fan_speed       = attributes.fan_speed;
+    out.temperature     = attributes.temperature;
+    out.time            = m_times[id];
+    out.layer_id        = attributes.layer_id;
+    out.internal_only   = attributes.internal_only;
+    return out;
+}
+
+void GCodeProcessorResult::Moves::set(size_t id, const MoveVertex& move)
+{
+    assert(id < size());
+    m_gcode_ids[id]        = move.gcode_id;
+    m_positions[id]        = move.position;
+    m_delta_extruders[id]  = move.delta_extruder;
+    m_actual_feedrates[id] = move.actual_feedrate;
+    m_times[id]            = move.time;
+    m_widths[id]           = move.width;
+    m_mm3_per_mms[id]      = move.mm3_per_mm;
+    m_attributes_ids[id]   = store_attributes(move, m_attributes_ids[id]);
+}
+
+void GCodeProcessorResult::Moves::erase(size_t id)
+{
+    assert(id < size());
+    m_gcode_ids.erase(m_gcode_ids.begin() + id);
+    m_positions.erase(m_positions.begin() + id);
+    m_delta_extruders.erase(m_delta_extruders.begin() + id);
+    m_actual_feedrates.erase(m_actual_feedrates.begin() + id);
+    m_times.erase(m_times.begin() + id);
+    m_widths.erase(m_widths.begin() + id);
+    m_mm3_per_mms.erase(m_mm3_per_mms.begin() + id);
+    m_attributes_ids.erase(m_attributes_ids.begin() + id);
+}
+
+void GCodeProcessorResult::Moves::copy(size_t src, size_t dst)
+{
+    assert(src < size() && dst < size());
+    m_gcode_ids[dst]        = m_gcode_ids[src];
+    m_positions[dst]        = m_positions[src];
+    m_delta_extruders[dst]  = m_delta_extruders[src];
+    m_actual_feedrates[dst] = m_actual_feedrates[src];
+    m_times[dst]            = m_times[src];
+    m_widths[dst]           = m_widths[src];
+    m_mm3_per_mms[dst]      = m_mm3_per_mms[src];
+    m_attributes_ids[dst]   = m_attributes_ids[src];
+}
+
+size_t GCodeProcessorResult::Moves::memsize() const
+{
+    return m_gcode_ids.capacity() * sizeof(unsigned int) + m_positions.capacity() * sizeof(Vec3f) +
+        m_delta_extruders.capacity() * sizeof(float) + m_actual_feedrates.capacity() * sizeof(float) +
+        m_times.capacity() * sizeof(Times) + m_widths.capacity() * sizeof(float) + m_mm3_per_mms.capacity() * sizeof(float) +
+        m_attributes_ids.capacity() * sizeof(unsigned int) + m_attributes.capacity() * sizeof(Attributes) +
+        // Estimate of a node and of a bucket of the hash map.
+        m_attributes_lookup.size() * (sizeof(std::pair<Attributes, unsigned int>) + 2 * sizeof(void*)) +
+        m_attributes_lookup.bucket_count() * sizeof(void*);
+}
+
+unsigned int GCodeProcessorResult::Moves::store_attributes(const MoveVertex& move, unsigned int hint)
+{
+    const Attributes attributes(move);
+    if (hint < m_attributes.size() && m_attributes[hint] == attributes)
+        return hint;
+    auto [it, inserted] = m_attributes_lookup.emplace(attributes, static_cast<unsigned int>(m_attributes.size()));
+    if (inserted)
+        m_attributes.emplace_back(attributes);
+    return it->second;
+}
+
 void GCodeProcessorResult::reset() {
     is_binary_file = false;
     moves.clear();
@@ -549,7 +812,7 @@ const std::vector<std::pair<GCodeProcessor::EProducer, std::string>> GCodeProces
     { EProducer::BambuStudio, "BambuStudio" }
 };
 
-unsigned int GCodeProcessor::s_result_id = 0;
+std::atomic<unsigned int> GCodeProcessor::s_result_id = 0;
 
 bool GCodeProcessor::contains_reserved_tag(const std::string& gcode, std::string& found_tag)
 {
@@ -1009,6 +1272,15 @@ void GCodeProcessor::enable_stealth_time_estimator(bool enabled)
     m_time_processor.machines[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Stealth)].enabled = enabled;
 }
 
+void GCodeProcessor::set_planner_checkpoints(GCodeProcessorResult::PlannerCheckpoints&& checkpoints)
+{
+    for (TimeMachine& machine : m_time_processor.machines)
+        machine.replayed_checkpoints = nullptr;
+    m_replayed_planner_checkpoints = std::move(checkpoints);
+    if (! m_replayed_planner_checkpoints.enabled)
+        m_replayed_planner_checkpoints.clear();
+}
+
 void GCodeProcessor::reset()
 {
     m_units = EUnits::Millimeters;
@@ -1062,6 +1334,12 @@ void GCodeProcessor::reset()
 
     m_result.reset();
     m_result.id = ++s_result_id;
+    m_result.planner_checkpoints.clear();
+    m_result.planner_checkpoints.enabled = m_replayed_planner_checkpoints.enabled;
+    for (size_t i = 0; i < static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count); ++i) {
+        if (! m_replayed_planner_checkpoints.machines[i].empty())
+            m_time_processor.machines[i].replayed_checkpoints = &m_replayed_planner_checkpoints.machines[i];
+    }
 
     m_use_volumetric_e = false;
     m_last_default_color_id = 0;
@@ -1156,7 +1434,7 @@ void GCodeProcessor::process_ascii_file(const std::string& filename, GCodeReader
     initialize_result_moves();
     size_t parse_line_callback_cntr = 10000;
     m_parser.set_progress_callback(progress_callback);
-    m_parser.parse_file(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
+    auto parse_line = [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
         if (-- parse_line_callback_cntr == 0) {
             // Don't call the cancel_callback() too often, do it every at every 10000'th line.
             parse_line_callback_cntr = 10000;
@@ -1164,7 +1442,12 @@ void GCodeProcessor::process_ascii_file(const std::string& filename, GCodeReader
                 cancel_callback();
         }
         this->process_gcode_line(line, true);
-    }, m_result.lines_ends);
+    };
+    if (m_statistics_only)
+        // The lines ends are only needed to synchronize the preview with the G-code.
+        m_parser.parse_file_parallel(filename, parse_line);
+    else
+        m_parser.parse_file_parallel(filename, parse_line, m_result.lines_ends);
 
     // Don't post-process the G-code to update time stamps.
     this->finalize(false);
@@ -1316,40 +1599,49 @@ void GCodeProcessor::process_binary_file(const std::string& filename, GCodeReade
         throw_error(format("Error reading file %1%: %2%", filename, std::string(translate_result(res))));
     if ((EBlockType)block_header.type != EBlockType::GCode)
         throw_error(format("Unable to find gcode block in file %1%", filename));
-    while ((EBlockType)block_header.type == EBlockType::GCode) {
+    // The gcode blocks are read and decompressed sequentially, while the already decompressed blocks are tokenized in parallel.
+    bool last_block_read = false;
+    m_parser.parse_parallel([&](std::string& chunk, std::string_view&) {
+        if (last_block_read || (EBlockType)block_header.type != EBlockType::GCode)
+            return false;
+
         GCodeBlock block;
         res = block.read_data(*file.f, file_header, block_header);
         update_progress();
         if (res != EResult::Success)
             throw_error(format("Error reading file %1%: %2%", filename, std::string(translate_result(res))));
 
-        std::vector<size_t>& lines_ends = m_result.lines_ends.emplace_back(std::vector<size_t>());
-        update_lines_ends_and_out_file_pos(block.raw_data, lines_ends, nullptr);
-
-        m_parser.parse_buffer(block.raw_data, [this](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
-            this->process_gcode_line(line, true);
-        });
+        if (! m_statistics_only) {
+            std::vector<size_t>& lines_ends = m_result.lines_ends.emplace_back(std::vector<size_t>());
+            update_lines_ends_and_out_file_pos(block.raw_data, lines_ends, nullptr);
+        }
+        chunk = std::move(block.raw_data);
 
         if (ftell(file.f) == file_size)
-            break;
-
-        res = read_next_block_header(*file.f, file_header, block_header, cs_buffer.data(), cs_buffer.size());
-        update_progress();
-        if (res != EResult::Success)
-            throw_error(format("Error reading file %1%: %2%", filename, std::string(translate_result(res))));
-    }
+            last_block_read = true;
+        else {
+            res = read_next_block_header(*file.f, file_header, block_header, cs_buffer.data(), cs_buffer.size());
+            update_progress();
+            if (res != EResult::Success)
+                throw_error(format("Error reading file %1%: %2%", filename, std::string(translate_result(res))));
+        }
+        return true;
+    }, [this](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
+        this->process_gcode_line(line, true);
+    });
 
     // Don't post-process the G-code to update time stamps.
     this->finalize(false);
 }
 
-void GCodeProcessor::initialize(const std::string& filename)
+void GCodeProcessor::initialize(const std::string& filename, const std::string& raw_filename)
 {
     assert(is_decimal_separator_point());
 
     // process gcode
     m_result.filename = filename;
     m_result.id = ++s_result_id;
+    m_raw_filename = raw_filename;
 }
 
 void GCodeProcessor::process_buffer(const std::string &buffer)
@@ -1365,10 +1657,12 @@ void GCodeProcessor::finalize(bool perform_post_process)
     m_result.z_offset = m_z_offset;
 
     // update width/height of wipe moves
-    for (GCodeProcessorResult::MoveVertex& move : m_result.moves) {
-        if (move.type == EMoveType::Wipe) {
+    for (size_t i = 0; i < m_result.moves.size(); ++i) {
+        if (m_result.moves.type(i) == EMoveType::Wipe) {
+            GCodeProcessorResult::MoveVertex move = m_result.moves[i];
             move.width = Wipe_Width;
             move.height = Wipe_Height;
+            m_result.moves.set(i, move);
         }
     }
 
@@ -1388,6 +1682,9 @@ void GCodeProcessor::finalize(bool perform_post_process)
 
     if (perform_post_process)
         post_process();
+
+    // The moves are complete, release the slack of the columns.
+    m_result.moves.shrink_to_fit();
 }
 
 float GCodeProcessor::get_time(PrintEstimatedStatistics::ETimeMode mode) const
@@ -2833,7 +3130,7 @@ void GCodeProcessor::process_G1(const std::array<std::optional<double>, 4>& axes
     if (m_time_processor.machines[0].blocks.size() > TimeProcessor::Planner::refresh_threshold)
         calculate_time(m_result, TimeProcessor::Planner::queue_size);
 
-    if (m_seams_detector.is_active() && (
+    if (! m_statistics_only && m_seams_detector.is_active() && (
         type != EMoveType::Extrude
         || (
             m_extrusion_role != GCodeExtrusionRole::ExternalPerimeter
@@ -2841,7 +3138,7 @@ void GCodeProcessor::process_G1(const std::array<std::optional<double>, 4>& axes
         )
     )) {
         const AxisCoords curr_pos = m_end_position;
-        const Vec3f new_pos = m_result.moves.back().position - m_extruder_offsets[m_extruder_id];
+        const Vec3f new_pos = m_result.moves.position(m_result.moves.size() - 1) - m_extruder_offsets[m_extruder_id];
         for (unsigned char a = X; a < E; ++a) {
             m_end_position[a] = double(new_pos[a]);
         }
@@ -3685,14 +3982,103 @@ void GCodeProcessor::process_T(const std::string_view command)
     }
 }
 
+// Appends the post-processed G-code to the binarizer on a worker thread, so that the compression and writing
+// of the G-code blocks by the binarizer overlaps with the post-processing of the following lines.
+// The G-code is appended in the order it was pushed. The amount of G-code waiting for the worker is bounded.
+class BinarizerWorker
+{
+public:
+    explicit BinarizerWorker(bgcode::binarize::Binarizer& binarizer) : m_binarizer(binarizer) {
+        m_thread = std::thread([this]() { this->run(); });
+    }
+    ~BinarizerWorker() {
+        if (m_thread.joinable()) {
+            // Post-processing failed, discard the pending G-code.
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_queue.clear();
+                m_finished = true;
+            }
+            m_cv_not_empty.notify_one();
+            m_thread.join();
+        }
+    }
+    BinarizerWorker(const BinarizerWorker&) = delete;
+    BinarizerWorker& operator=(const BinarizerWorker&) = delete;
+
+    void push(std::string&& gcode) {
+        if (gcode.empty())
+            return;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_not_full.wait(lock, [this]() { return m_pending_size < MAX_PENDING_SIZE || m_failed; });
+        if (m_failed)
+            throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
+        m_pending_size += gcode.size();
+        m_queue.emplace_back(std::move(gcode));
+        lock.unlock();
+        m_cv_not_empty.notify_one();
+    }
+
+    // Wait until all the pushed G-code is appended to the binarizer.
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished = true;
+        }
+        m_cv_not_empty.notify_one();
+        m_thread.join();
+        if (m_failed)
+            throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
+    }
+
+private:
+    static constexpr size_t MAX_PENDING_SIZE = 16 * 1024 * 1024;
+
+    void run() {
+        set_current_thread_name("slic3r_bgcode");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cv_not_empty.wait(lock, [this]() { return ! m_queue.empty() || m_finished; });
+            if (m_queue.empty())
+                break;
+            std::string gcode = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            const bool success = m_binarizer.append_gcode(gcode) == bgcode::core::EResult::Success;
+            lock.lock();
+            m_pending_size -= gcode.size();
+            if (! success) {
+                m_failed = true;
+                m_queue.clear();
+            }
+            m_cv_not_full.notify_one();
+            if (m_failed)
+                break;
+        }
+    }
+
+    bgcode::binarize::Binarizer& m_binarizer;
+    std::thread                  m_thread;
+    std::mutex                   m_mutex;
+    std::condition_variable      m_cv_not_empty;
+    std::condition_variable      m_cv_not_full;
+    std::deque<std::string>      m_queue;
+    size_t                       m_pending_size{ 0 };
+    bool                         m_finished{ false };
+    bool                         m_failed{ false };
+};
+
 void GCodeProcessor::post_process()
 {
-    FilePtr in{ boost::nowide::fopen(m_result.filename.c_str(), "rb") };
+    // Either stream the raw G-code directly into the final file, or post process the final file in place through a temporary file.
+    const bool  has_raw_file = ! m_raw_filename.empty();
+    const std::string in_path = has_raw_file ? m_raw_filename : m_result.filename;
+    FilePtr in{ boost::nowide::fopen(in_path.c_str(), "rb") };
     if (in.f == nullptr)
         throw Slic3r::RuntimeError(std::string("GCode processor post process export failed.\nCannot open file for reading.\n"));
 
-    // temporary file to contain modified gcode
-    std::string out_path = m_result.filename + ".postprocess";
+    // file to contain modified gcode
+    std::string out_path = has_raw_file ? m_result.filename : m_result.filename + ".postprocess";
     FilePtr out{ boost::nowide::fopen(out_path.c_str(), "wb") };
     if (out.f == nullptr)
         throw Slic3r::RuntimeError(std::string("GCode processor post process export failed.\nCannot open file for writing.\n"));
@@ -3760,6 +4146,10 @@ void GCodeProcessor::post_process()
         if (res != bgcode::core::EResult::Success)
             throw Slic3r::RuntimeError(format("Unable to initialize the gcode binarizer.\nError: %1%", bgcode::core::translate_result(res)));
     }
+    // The G-code blocks are compressed and written by the binarizer on a worker thread.
+    std::optional<BinarizerWorker> binarizer_worker;
+    if (m_binarizer.is_enabled())
+        binarizer_worker.emplace(m_binarizer);
 
     auto time_in_minutes = [](float time_in_seconds) {
         assert(time_in_seconds >= 0.f);
@@ -3883,15 +4273,16 @@ void GCodeProcessor::post_process()
         size_t m_times_cache_id{ 0 };
         size_t m_out_file_pos{ 0 };
 
-        bgcode::binarize::Binarizer& m_binarizer;
+        // nullptr if exporting an ASCII G-code.
+        BinarizerWorker* m_binarizer_worker;
 
     public:
-        ExportLines(bgcode::binarize::Binarizer& binarizer, EWriteType type,
+        ExportLines(BinarizerWorker* binarizer_worker, EWriteType type,
             const std::array<TimeMachine, static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count)>& machines)
 #ifndef NDEBUG
-        : m_statistics(*this), m_binarizer(binarizer), m_write_type(type), m_machines(machines) {}
+        : m_statistics(*this), m_binarizer_worker(binarizer_worker), m_write_type(type), m_machines(machines) {}
 #else
-        : m_binarizer(binarizer), m_write_type(type), m_machines(machines) {}
+        : m_binarizer_worker(binarizer_worker), m_write_type(type), m_machines(machines) {}
 #endif // NDEBUG
 
         // return: number of internal G1 lines (from G2/G3 splitting) processed
@@ -4035,13 +4426,12 @@ void GCodeProcessor::post_process()
                 }
             }
 
-            if (m_binarizer.is_enabled()) {
-                if (m_binarizer.append_gcode(out_string) != bgcode::core::EResult::Success)
-                    throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
-            }
+            if (m_binarizer_worker != nullptr)
+                m_binarizer_worker->push(std::move(out_string));
             else {
                 write_to_file(out, out_string, result, out_path);
-                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
+                if (! result.lines_ends.empty())
+                    update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
             }
         }
 
@@ -4058,24 +4448,24 @@ void GCodeProcessor::post_process()
             m_statistics.remove_all_lines();
 #endif // NDEBUG
 
-            if (m_binarizer.is_enabled()) {
-                if (m_binarizer.append_gcode(out_string) != bgcode::core::EResult::Success)
-                    throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
-            }
+            if (m_binarizer_worker != nullptr)
+                m_binarizer_worker->push(std::move(out_string));
             else {
                 write_to_file(out, out_string, result, out_path);
-                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
+                if (! result.lines_ends.empty())
+                    update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
             }
         }
 
         void synchronize_moves(GCodeProcessorResult& result) const {
             auto it = m_gcode_lines_map.begin();
-            for (GCodeProcessorResult::MoveVertex& move : result.moves) {
-                while (it != m_gcode_lines_map.end() && it->first < move.gcode_id) {
+            for (size_t i = 0; i < result.moves.size(); ++i) {
+                unsigned int& gcode_id = result.moves.gcode_id(i);
+                while (it != m_gcode_lines_map.end() && it->first < gcode_id) {
                     ++it;
                 }
-                if (it != m_gcode_lines_map.end() && it->first == move.gcode_id)
-                    move.gcode_id = it->second;
+                if (it != m_gcode_lines_map.end() && it->first == gcode_id)
+                    gcode_id = it->second;
             }
         }
 
@@ -4084,7 +4474,7 @@ void GCodeProcessor::post_process()
     private:
         void write_to_file(FilePtr& out, const std::string& out_string, GCodeProcessorResult& result, const std::string& out_path) {
             if (!out_string.empty()) {
-                if (!m_binarizer.is_enabled()) {
+                if (m_binarizer_worker == nullptr) {
                     fwrite((const void*)out_string.c_str(), 1, out_string.length(), out.f);
                     if (ferror(out.f)) {
                         out.close();
@@ -4096,7 +4486,7 @@ void GCodeProcessor::post_process()
         }
     };
 
-    ExportLines export_lines(m_binarizer, m_result.backtrace_enabled ? ExportLines::EWriteType::ByTime : ExportLines::EWriteType::BySize,
+    ExportLines export_lines(binarizer_worker ? &*binarizer_worker : nullptr, m_result.backtrace_enabled ? ExportLines::EWriteType::ByTime : ExportLines::EWriteType::BySize,
         m_time_processor.machines);
 
     // replace placeholder lines with the proper final value
@@ -4329,7 +4719,8 @@ void GCodeProcessor::post_process()
     };
 
     m_result.lines_ends.clear();
-    m_result.lines_ends.emplace_back(std::vector<size_t>());
+    if (! m_statistics_only)
+        m_result.lines_ends.emplace_back(std::vector<size_t>());
 
     unsigned int line_id = 0;
     // Backtrace data for Tx gcode lines
@@ -4412,6 +4803,7 @@ void GCodeProcessor::post_process()
     export_lines.flush(out, m_result, out_path);
 
     if (m_binarizer.is_enabled()) {
+        binarizer_worker->finish();
         if (m_binarizer.finalize() != bgcode::core::EResult::Success)
             throw Slic3r::RuntimeError("Error while finalizing the gcode binarizer.");
     }
@@ -4420,7 +4812,7 @@ void GCodeProcessor::post_process()
     in.close();
 
     const std::string result_filename = m_result.filename;
-    if (m_binarizer.is_enabled()) {
+    if (m_binarizer.is_enabled() && ! m_statistics_only) {
         // The list of lines in the binary gcode is different from the original one.
         // This requires to re-process the binarized file to be able to synchronize with it all the data needed by the preview,
         // as gcode window, tool position and moves slider which relies on indexing the gcode lines.
@@ -4433,7 +4825,10 @@ void GCodeProcessor::post_process()
     else
         export_lines.synchronize_moves(m_result);
 
-    if (rename_file(out_path, result_filename))
+    if (has_raw_file) {
+        boost::nowide::remove(m_raw_filename.c_str());
+        m_raw_filename.clear();
+    } else if (rename_file(out_path, result_filename))
         throw Slic3r::RuntimeError(std::string("Failed to rename the output G-code file from ") + out_path + " to " + result_filename + '\n' +
             "Is " + out_path + " locked?" + '\n');
 }
@@ -4444,25 +4839,26 @@ void GCodeProcessor::store_move_vertex(EMoveType type, bool internal_only)
         m_line_id + 1 :
         ((type == EMoveType::Seam) ? m_last_line_id : m_line_id);
 
-    m_result.moves.push_back({
-        m_last_line_id,
-        type,
-        m_extrusion_role,
-        m_extruder_id,
-        m_cp_color.current,
-        Vec3f(m_end_position[X], m_end_position[Y], m_end_position[Z] - m_z_offset) + m_extruder_offsets[m_extruder_id],
-        static_cast<float>(m_end_position[E] - m_start_position[E]),
-        m_feedrate,
-        0.0f, // actual feedrate
-        m_width,
-        m_height,
-        m_mm3_per_mm,
-        m_fan_speed,
-        m_extruder_temps[m_extruder_id],
-        { 0.0f, 0.0f }, // time
-        std::max<unsigned int>(1, m_layer_id) - 1,
-        internal_only
-    });
+    if (! m_statistics_only)
+        m_result.moves.push_back({
+            m_last_line_id,
+            type,
+            m_extrusion_role,
+            m_extruder_id,
+            m_cp_color.current,
+            Vec3f(m_end_position[X], m_end_position[Y], m_end_position[Z] - m_z_offset) + m_extruder_offsets[m_extruder_id],
+            static_cast<float>(m_end_position[E] - m_start_position[E]),
+            m_feedrate,
+            0.0f, // actual feedrate
+            m_width,
+            m_height,
+            m_mm3_per_mm,
+            m_fan_speed,
+            m_extruder_temps[m_extruder_id],
+            { 0.0f, 0.0f }, // time
+            std::max<unsigned int>(1, m_layer_id) - 1,
+            internal_only
+        });
 
     // stores stop time placeholders for later use
     if (type == EMoveType::Color_change || type == EMoveType::Pause_Print) {
@@ -4673,20 +5069,17 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult& result, size_t keep_la
             id_map[base_id_old]          = base_id_old + inserted_count; // Remember where the old element will end up.
             inserted_count += moves_to_insert.back().second.size();      // Increase the number of moves that are already planned to be added.
 
-            result.moves[base_id_old].actual_feedrate = it->actual_feedrate; // update move actual speed
+            result.moves.actual_feedrate(base_id_old) = it->actual_feedrate; // update move actual speed
             
             // synchronize seams actual speed
-            if (base_id_old + 1 < result.moves.size()) {
-                GCodeProcessorResult::MoveVertex& move = result.moves[base_id_old + 1];
-                if (move.type == EMoveType::Seam)
-                    move.actual_feedrate = it->actual_feedrate;
-            }
+            if (base_id_old + 1 < result.moves.size() && result.moves.type(base_id_old + 1) == EMoveType::Seam)
+                result.moves.actual_feedrate(base_id_old + 1) = it->actual_feedrate;
             moves_to_insert.emplace_back(std::make_pair(0, std::vector<GCodeProcessorResult::MoveVertex>{}));
         }
     }
 
     // Now actually do the insertion of the ranges into the destination vector.
-    std::vector<GCodeProcessorResult::MoveVertex>& m = result.moves;
+    GCodeProcessorResult::Moves& m = result.moves;
     size_t offset = inserted_count;    
     m.resize(m.size() + offset); // grow the vector to its final size   
     size_t last_pos = m.size() - 1;  // index of the last element that still needs to be moved
@@ -4695,8 +5088,9 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult& result, size_t keep_la
         if (new_moves.empty())
             continue;
         for (int i = last_pos; i >= new_pos + new_moves.size(); --i) // Move the elements to their final place.
-            m[i] = m[i - offset];
-        std::copy(new_moves.begin(), new_moves.end(), m.begin() + new_pos);
+            m.copy(i - offset, i);
+        for (size_t i = 0; i < new_moves.size(); ++i)
+            m.set(new_pos + i, new_moves[i]);
         last_pos = new_pos - 1;
         offset -= new_moves.size();
     }
@@ -4722,6 +5116,7 @@ void GCodeProcessor::update_estimated_statistics()
         PrintEstimatedStatistics::Mode& data = m_result.print_statistics.modes[static_cast<size_t>(mode)];
         data.time = get_time(mode);
         data.custom_gcode_times = get_custom_gcode_times(mode, true);
+        data.layers_times = m_time_processor.machines[static_cast<size_t>(mode)].layers_time;
     };
 
     update_mode(PrintEstimatedStatistics::ETimeMode::Normal);
@@ -9,12 +9,16 @@
 
 #include <LibBGCode/binarize/binarize.hpp>
 
+#include <cassert>
 #include <cstdint>
 #include <array>
+#include <atomic>
+#include <iterator>
 #include <vector>
 #include <string>
 #include <string_view>
 #include <optional>
+#include <unordered_map>
 
 namespace Slic3r {
 
@@ -49,11 +53,15 @@ namespace Slic3r {
         {
             float time;
             std::vector<std::pair<CustomGCode::Type, std::pair<float, float>>> custom_gcode_times;
+            // Print time of each layer, indexed by layer_id - 1.
+            std::vector<float> layers_times;
 
             void reset() {
                 time = 0.0f;
                 custom_gcode_times.clear();
                 custom_gcode_times.shrink_to_fit();
+                layers_times.clear();
+                layers_times.shrink_to_fit();
             }
         };
 
@@ -133,10 +141,147 @@ namespace Slic3r {
             float actual_volumetric_rate() const { return actual_feedrate * mm3_per_mm; }
         };
 
+        // Moves stored column wise. The attributes, which rarely change from one move to the next (type, role, extruder,
+        // feedrate, height, fan speed ...), are stored into a table of distinct attribute sets shared by all the moves.
+        // The width and mm3_per_mm are calculated from the extrusion of each move, thus they are stored per move.
+        // A move occupies about two thirds of sizeof(MoveVertex). A move is materialized into a MoveVertex when accessed,
+        // the columns updated in place by the processor (gcode id, position, actual feedrate and times) are also accessible by reference.
+        class Moves
+        {
+            struct Attributes
+            {
+                EMoveType type{ EMoveType::Noop };
+                GCodeExtrusionRole extrusion_role{ GCodeExtrusionRole::None };
+                unsigned char extruder_id{ 0 };
+                unsigned char cp_color_id{ 0 };
+                bool internal_only{ false };
+                float feedrate{ 0.0f };
+                float height{ 0.0f };
+                float fan_speed{ 0.0f };
+                float temperature{ 0.0f };
+                unsigned int layer_id{ 0 };
+
+                Attributes() = default;
+                explicit Attributes(const MoveVertex& move);
+
+                bool operator==(const Attributes& rhs) const;
+                bool operator!=(const Attributes& rhs) const { return !(*this == rhs); }
+            };
+            struct AttributesHash
+            {
+                size_t operator()(const Attributes& attributes) const;
+            };
+
+        public:
+            using Times = std::array<float, static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count)>;
+
+            // Iterates over the moves materialized into MoveVertex.
+            class const_iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type        = MoveVertex;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = void;
+                using reference         = MoveVertex;
+
+                const_iterator() = default;
+                const_iterator(const Moves* moves, size_t id) : m_moves(moves), m_id(id) {}
+
+                MoveVertex      operator*() const { return (*m_moves)[m_id]; }
+                const_iterator& operator++() { ++m_id; return *this; }
+                const_iterator  operator++(int) { const_iterator out = *this; ++m_id; return out; }
+                bool            operator==(const const_iterator& rhs) const { return m_id == rhs.m_id; }
+                bool            operator!=(const const_iterator& rhs) const { return m_id != rhs.m_id; }
+                size_t          id() const { return m_id; }
+
+            private:
+                const Moves* m_moves{ nullptr };
+                size_t       m_id{ 0 };
+            };
+
+            size_t size() const { return m_gcode_ids.size(); }
+            bool   empty() const { return m_gcode_ids.empty(); }
+            void   clear();
+            void   reserve(size_t n);
+            void   shrink_to_fit();
+            // New moves are default constructed MoveVertices.
+            void   resize(size_t n);
+
+            void       push_back(const MoveVertex& move);
+            MoveVertex operator[](size_t id) const;
+            MoveVertex back() const { assert(!empty()); return (*this)[size() - 1]; }
+            void       set(size_t id, const MoveVertex& move);
+            void       erase(size_t id);
+            // Overwrite move dst with a copy of move src.
+            void       copy(size_t src, size_t dst);
+
+            const_iterator begin() const { return { this, 0 }; }
+            const_iterator end() const { return { this, size() }; }
+
+            EMoveType           type(size_t id) const { return m_attributes[m_attributes_ids[id]].type; }
+            unsigned int&       gcode_id(size_t id) { return m_gcode_ids[id]; }
+            unsigned int        gcode_id(size_t id) const { return m_gcode_ids[id]; }
+            Vec3f&              position(size_t id) { return m_positions[id]; }
+            const Vec3f&        position(size_t id) const { return m_positions[id]; }
+            float               delta_extruder(size_t id) const { return m_delta_extruders[id]; }
+            float&              actual_feedrate(size_t id) { return m_actual_feedrates[id]; }
+            float               actual_feedrate(size_t id) const { return m_actual_feedrates[id]; }
+            Times&              time(size_t id) { return m_times[id]; }
+            const Times&        time(size_t id) const { return m_times[id]; }
+
+            // Number of distinct attribute sets stored.
+            size_t attributes_count() const { return m_attributes.size(); }
+            // Memory allocated by the store, in bytes.
+            size_t memsize() const;
+
+        private:
+            // Returns the index of the attributes of the given move into m_attributes, adding them if not found.
+            // The attributes with the index hint are tested first, as consecutive moves mostly share their attributes.
+            unsigned int store_attributes(const MoveVertex& move, unsigned int hint);
+
+            std::vector<unsigned int> m_gcode_ids;
+            std::vector<Vec3f>        m_positions;
+            std::vector<float>        m_delta_extruders;
+            std::vector<float>        m_actual_feedrates;
+            std::vector<Times>        m_times;
+            std::vector<float>        m_widths;
+            std::vector<float>        m_mm3_per_mms;
+            std::vector<unsigned int> m_attributes_ids;
+            std::vector<Attributes>   m_attributes;
+            // Index of each of m_attributes into m_attributes.
+            std::unordered_map<Attributes, unsigned int, AttributesHash> m_attributes_lookup;
+        };
+
+        // State of the time estimator's planner queue, recorded each time the planner of a TimeMachine runs.
+        struct PlannerCheckpoint
+        {
+            // Hash of the blocks entering the planner queue since the previous checkpoint.
+            size_t input_hash{ 0 };
+            // Layer of the last block in the queue, the checkpoint is only replayed for the same layer.
+            unsigned int layer_id{ 0 };
+            // Planned entry feedrate, exit feedrate, accelerate_until, decelerate_after and cruise feedrate of the queued blocks.
+            std::vector<std::array<float, 5>> blocks;
+        };
+
+        // Opt-in: With enabled set, GCodeProcessor records the planner checkpoints into the result.
+        // Exporting the same print again into the result then replays the checkpoints instead of running the planner,
+        // as long as the planner input matches the recorded one, that is up to the first layer that changed.
+        // Kept by reset(), so that the checkpoints survive until the next export.
+        struct PlannerCheckpoints
+        {
+            bool enabled{ false };
+            std::array<std::vector<PlannerCheckpoint>, static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count)> machines;
+            // Number of checkpoints of the previous export replayed by the last export, summed over the time modes.
+            size_t num_replayed{ 0 };
+
+            void clear() { machines = {}; num_replayed = 0; }
+        };
+
         std::string filename;
         bool is_binary_file;
         unsigned int id;
-        std::vector<MoveVertex> moves;
+        Moves moves;
         // Positions of ends of lines of the final G-code this->filename after TimeProcessor::post_process() finalizes the G-code.
         // Binarized gcodes usually have several gcode blocks. Each block has its own list on ends of lines.
         // Ascii gcodes have only one list on ends of lines
@@ -159,6 +304,8 @@ namespace Slic3r {
         ConflictResultOpt conflict_result;
         std::optional<std::pair<std::string, std::string>> sequential_collision_detected;
 
+        PlannerCheckpoints planner_checkpoints;
+
         void reset();
     };
 
@@ -352,7 +499,13 @@ namespace Slic3r {
             std::vector<TimeBlock> blocks;
             std::vector<G1LinesCacheItem> g1_times_cache;
             float first_layer_time;
+            std::vector<float> layers_time;
             std::vector<ActualSpeedMove> actual_speed_moves;
+            // Number of leading blocks already planned by a previous calculate_time().
+            size_t planned_blocks;
+            // Planner checkpoints of a previous export replayed by calculate_time(), nullptr once the planner input diverged.
+            const std::vector<GCodeProcessorResult::PlannerCheckpoint>* replayed_checkpoints;
+            size_t replayed_checkpoints_count;
 
             void reset();
 
@@ -449,6 +602,9 @@ namespace Slic3r {
             }
 
             void set() {
+                // No moves are stored in the statistics only mode.
+                if (m_result.moves.empty())
+                    return;
                 m_move_id = m_result.moves.size() - 1;
                 m_custom_gcode_per_print_z_id = m_result.custom_gcode_per_print_z.size() - 1;
             }
@@ -457,12 +613,13 @@ namespace Slic3r {
                 if (!m_move_id.has_value() || !m_custom_gcode_per_print_z_id.has_value())
                     return;
 
-                const Vec3f position = m_result.moves.back().position;
+                const Vec3f position = m_result.moves.position(m_result.moves.size() - 1);
 
-                GCodeProcessorResult::MoveVertex& move = m_result.moves.emplace_back(m_result.moves[*m_move_id]);
+                GCodeProcessorResult::MoveVertex move = m_result.moves[*m_move_id];
                 move.position = position;
                 move.height = height;
-                m_result.moves.erase(m_result.moves.begin() + *m_move_id);
+                m_result.moves.push_back(move);
+                m_result.moves.erase(*m_move_id);
                 m_result.custom_gcode_per_print_z[*m_custom_gcode_per_print_z_id].print_z = position.z();
                 reset();
             }
@@ -555,11 +712,18 @@ namespace Slic3r {
 
         TimeProcessor m_time_processor;
         UsedFilaments m_used_filaments;
+        // Planner checkpoints of a previous export, see set_planner_checkpoints().
+        GCodeProcessorResult::PlannerCheckpoints m_replayed_planner_checkpoints;
+        // See enable_statistics_only().
+        bool m_statistics_only{ false };
 
         Print* m_print{ nullptr };
 
         GCodeProcessorResult m_result;
-        static unsigned int s_result_id;
+        // Incremented by processors running in parallel, for example when estimating print times of G-code files in batch.
+        static std::atomic<unsigned int> s_result_id;
+        // G-code as exported by GCodeGenerator, if stored separately from m_result.filename, see initialize().
+        std::string m_raw_filename;
 
     public:
         GCodeProcessor();
@@ -574,6 +738,12 @@ namespace Slic3r {
             return m_time_processor.machines[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Stealth)].enabled;
         }
         void enable_machine_envelope_processing(bool enabled) { m_time_processor.machine_envelope_processing_enabled = enabled; }
+        // Replay the planner checkpoints recorded by a previous export of the same print and record the new ones,
+        // if checkpoints.enabled is set. See GCodeProcessorResult::PlannerCheckpoints. Takes effect with the next reset().
+        void set_planner_checkpoints(GCodeProcessorResult::PlannerCheckpoints&& checkpoints);
+        // Only calculate the print statistics (times, used filament, layers), don't store the moves and the lines ends
+        // needed by the preview. Used when the result is not going to be visualized. Not affected by reset().
+        void enable_statistics_only(bool enabled) { m_statistics_only = enabled; }
         void reset();
 
         const GCodeProcessorResult& get_result() const { return m_result; }
@@ -585,11 +755,15 @@ namespace Slic3r {
             std::function<void(void)> cancel_callback = nullptr);
 
         // Streaming interface, for processing G-codes just generated by QIDISlicer in a pipelined fashion.
-        void initialize(const std::string& filename);
+        // If raw_filename is set, the generated G-code is stored there and post_process() streams it into filename
+        // in a single pass and then removes it, otherwise filename is post processed into a temporary file and replaced.
+        void initialize(const std::string& filename, const std::string& raw_filename = {});
         void initialize_result_moves() {
+            if (m_statistics_only)
+                return;
             // 1st move must be a dummy move
             assert(m_result.moves.empty());
-            m_result.moves.emplace_back(GCodeProcessorResult::MoveVertex());
+            m_result.moves.push_back(GCodeProcessorResult::MoveVertex());
         }
         void process_buffer(const std::string& buffer);
         void finalize(bool post_process);
@@ -739,7 +913,7 @@ namespace Slic3r {
         void process_T(const GCodeReader::GCodeLine& line);
         void process_T(const std::string_view command);
 
-        // post process the file with the given filename to:
+        // post process the raw file (or the file with the given filename) to:
         // 1) add remaining time lines M73 and update moves' gcode ids accordingly
         // 2) update used filament data
         void post_process();
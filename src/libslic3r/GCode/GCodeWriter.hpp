@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <vector>
 #include <cstring>
 
@@ -226,43 +227,75 @@ public:
     static Vec2d                                  quantize(const Vec2f &pt)
         { return { quantize(double(pt.x()), XYZF_EXPORT_DIGITS), quantize(double(pt.y()), XYZF_EXPORT_DIGITS) }; }
 
+    // Emit " <axis><v>" with v rounded to Digits decimal digits. Trailing zeros of the fractional part are omitted,
+    // so is the decimal point of an integral value and the integer part of a value smaller than one ("X.5").
+    template<int Digits>
+    void emit_axis(const char axis, const double v) {
+        static_assert(Digits >= 0 && Digits <= 9);
+        constexpr uint64_t scale = uint64_t(pow_10[Digits]);
+        char *ptr = ptr_err.ptr;
+        *ptr ++ = ' '; *ptr ++ = axis;
+        const int64_t v_int = int64_t(std::round(v * pow_10[Digits]));
+        // Branch-less sign.
+        *ptr = '-';
+        ptr += v_int < 0;
+        const uint64_t v_abs     = v_int < 0 ? uint64_t(0) - uint64_t(v_int) : uint64_t(v_int);
+        const uint64_t int_part  = v_abs / scale;
+        const uint64_t frac_part = v_abs - int_part * scale;
+        // The number is composed right aligned to the decimal point at tmp + 20, which leaves space for any uint64_t integer part.
+        char  tmp[32];
+        char *end   = tmp + 20;
+        char *begin = int_part != 0 || frac_part == 0 ? write_digits(end, int_part) : end;
+        if constexpr (Digits > 0) {
+            *end = '.';
+            write_fixed_digits<Digits>(end + 1 + Digits, frac_part);
+            // Strip the trailing zeros, then the decimal point if the value is integral.
+            char *last = end + Digits;
+            while (*last == '0')
+                -- last;
+            end = last + (*last != '.');
+        }
+        memcpy(ptr, begin, end - begin);
+        ptr_err.ptr = ptr + (end - begin);
+    }
+    // Dispatches to emit_axis<digits>().
     void emit_axis(const char axis, const double v, size_t digits);
 
     void emit_xy(const Vec2d &point) {
-        this->emit_axis('X', point.x(), XYZF_EXPORT_DIGITS);
-        this->emit_axis('Y', point.y(), XYZF_EXPORT_DIGITS);
+        this->emit_axis<XYZF_EXPORT_DIGITS>('X', point.x());
+        this->emit_axis<XYZF_EXPORT_DIGITS>('Y', point.y());
     }
 
     void emit_xyz(const Vec3d &point) {
-        this->emit_axis('X', point.x(), XYZF_EXPORT_DIGITS);
-        this->emit_axis('Y', point.y(), XYZF_EXPORT_DIGITS);
+        this->emit_axis<XYZF_EXPORT_DIGITS>('X', point.x());
+        this->emit_axis<XYZF_EXPORT_DIGITS>('Y', point.y());
         this->emit_z(point.z());
     }
 
     void emit_z(const double z) {
-        this->emit_axis('Z', z, XYZF_EXPORT_DIGITS);
+        this->emit_axis<XYZF_EXPORT_DIGITS>('Z', z);
     }
 
     void emit_ij(const Vec2d &point) {
         if (point.x() != 0)
-            this->emit_axis('I', point.x(), XYZF_EXPORT_DIGITS);
+            this->emit_axis<XYZF_EXPORT_DIGITS>('I', point.x());
         if (point.y() != 0)
-            this->emit_axis('J', point.y(), XYZF_EXPORT_DIGITS);
+            this->emit_axis<XYZF_EXPORT_DIGITS>('J', point.y());
     }
 
     void emit_e(const std::string_view axis, double v) {
-        const double precision{std::pow(10.0, -E_EXPORT_DIGITS)};
+        const double precision = pow_10_inv[E_EXPORT_DIGITS];
         if (std::abs(v) < precision) {
             v = v < 0 ? -precision : precision;
         }
         if (! axis.empty()) {
             // not gcfNoExtrusion
-            this->emit_axis(axis[0], v, E_EXPORT_DIGITS);
+            this->emit_axis<E_EXPORT_DIGITS>(axis[0], v);
         }
     }
 
     void emit_f(double speed) {
-        this->emit_axis('F', speed, XYZF_EXPORT_DIGITS);
+        this->emit_axis<XYZF_EXPORT_DIGITS>('F', speed);
     }
 
     void emit_string(const std::string_view s) {
@@ -284,6 +317,39 @@ public:
     }
 
 protected:
+    static constexpr const char digits_pairs[201] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // Write n in decimal ending at end, return the first character written.
+    static char* write_digits(char *end, uint64_t n) {
+        char *p = end;
+        while (n >= 100) {
+            p -= 2;
+            memcpy(p, digits_pairs + size_t(n % 100) * 2, 2);
+            n /= 100;
+        }
+        if (n >= 10) {
+            p -= 2;
+            memcpy(p, digits_pairs + size_t(n) * 2, 2);
+        } else
+            *-- p = char('0' + n);
+        return p;
+    }
+
+    // Write exactly Count decimal digits of n, zero padded, ending at end.
+    template<int Count>
+    static void write_fixed_digits(char *end, uint64_t n) {
+        if constexpr (Count >= 2) {
+            memcpy(end - 2, digits_pairs + size_t(n % 100) * 2, 2);
+            write_fixed_digits<Count - 2>(end - 2, n / 100);
+        } else if constexpr (Count == 1)
+            end[-1] = char('0' + n);
+    }
+
     static constexpr const size_t   buflen = 256;
     char                            buf[buflen];
     char* buf_end;
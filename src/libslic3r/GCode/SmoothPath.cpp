@@ -5,6 +5,8 @@
 #include <iterator>
 #include <utility>
 #include <cassert>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 
 #include "../ExtrusionEntity.hpp"
 #include "../ExtrusionEntityCollection.hpp"
@@ -120,7 +122,7 @@ void reverse(SmoothPath &path) {
         Geometry::ArcWelder::reverse(path_element.path);
 }
 
-void SmoothPathCache::interpolate_add(const ExtrusionPath &path, const InterpolationParameters &params)
+static Geometry::ArcWelder::Path interpolate(const ExtrusionPath &path, const SmoothPathCache::InterpolationParameters &params)
 {
     double tolerance = params.tolerance;
     if (path.role().is_sparse_infill())
@@ -133,7 +135,30 @@ void SmoothPathCache::interpolate_add(const ExtrusionPath &path, const Interpola
         // Brim is currently marked as skirt.
         // Use 4x lower resolution than the object fine detail for skirt & brim.
         tolerance *= 4.;
-    m_cache[&path.polyline] = Slic3r::Geometry::ArcWelder::fit_path(path.polyline.points, tolerance, params.fit_circle_tolerance);
+    return Slic3r::Geometry::ArcWelder::fit_path(path.polyline.points, tolerance, params.fit_circle_tolerance);
+}
+
+static void collect_extrusion_paths(const ExtrusionEntityCollection &eec, std::vector<const ExtrusionPath*> &out)
+{
+    for (const ExtrusionEntity *ee : eec) {
+        if (ee->is_collection())
+            collect_extrusion_paths(*static_cast<const ExtrusionEntityCollection*>(ee), out);
+        else if (const ExtrusionPath *path = dynamic_cast<const ExtrusionPath*>(ee); path)
+            out.emplace_back(path);
+        else if (const ExtrusionMultiPath *multi_path = dynamic_cast<const ExtrusionMultiPath*>(ee); multi_path)
+            for (const ExtrusionPath &path : multi_path->paths)
+                out.emplace_back(&path);
+        else if (const ExtrusionLoop *loop = dynamic_cast<const ExtrusionLoop*>(ee); loop)
+            for (const ExtrusionPath &path : loop->paths)
+                out.emplace_back(&path);
+        else
+            assert(false);
+    }
+}
+
+void SmoothPathCache::interpolate_add(const ExtrusionPath &path, const InterpolationParameters &params)
+{
+    m_cache[&path.polyline] = interpolate(path, params);
 }
 
 void SmoothPathCache::interpolate_add(const ExtrusionMultiPath &multi_path, const InterpolationParameters &params)
@@ -150,18 +175,25 @@ void SmoothPathCache::interpolate_add(const ExtrusionLoop &loop, const Interpola
 
 void SmoothPathCache::interpolate_add(const ExtrusionEntityCollection &eec, const InterpolationParameters &params)
 {
-    for (const ExtrusionEntity *ee : eec) {
-        if (ee->is_collection())
-            this->interpolate_add(*static_cast<const ExtrusionEntityCollection*>(ee), params);
-        else if (const ExtrusionPath *path = dynamic_cast<const ExtrusionPath*>(ee); path)
-            this->interpolate_add(*path, params);
-        else if (const ExtrusionMultiPath *multi_path = dynamic_cast<const ExtrusionMultiPath*>(ee); multi_path)
-            this->interpolate_add(*multi_path, params);
-        else if (const ExtrusionLoop *loop = dynamic_cast<const ExtrusionLoop*>(ee); loop)
-            this->interpolate_add(*loop, params);
-        else
-            assert(false);
-    }
+    const ExtrusionEntityCollection *collections[] { &eec };
+    this->interpolate_add(collections, params);
+}
+
+void SmoothPathCache::interpolate_add(tcb::span<const ExtrusionEntityCollection* const> collections, const InterpolationParameters &params)
+{
+    std::vector<const ExtrusionPath*> paths;
+    for (const ExtrusionEntityCollection *eec : collections)
+        collect_extrusion_paths(*eec, paths);
+    // Arc fitting of a single layer may take long enough to be worth splitting into multiple tasks,
+    // even though the layers are interpolated in parallel by GCodeGenerator::process_layers().
+    std::vector<Geometry::ArcWelder::Path> fitted(paths.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, paths.size(), 16), [&paths, &fitted, &params](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i)
+            fitted[i] = interpolate(*paths[i], params);
+    });
+    m_cache.reserve(m_cache.size() + paths.size());
+    for (size_t i = 0; i < paths.size(); ++ i)
+        m_cache[&paths[i]->polyline] = std::move(fitted[i]);
 }
 
 const Geometry::ArcWelder::Path* SmoothPathCache::resolve(const Polyline *pl) const
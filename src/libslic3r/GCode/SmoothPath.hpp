@@ -52,6 +52,8 @@ public:
     void interpolate_add(const ExtrusionMultiPath        &ee,  const InterpolationParameters &params);
     void interpolate_add(const ExtrusionLoop             &ee,  const InterpolationParameters &params);
     void interpolate_add(const ExtrusionEntityCollection &eec, const InterpolationParameters &params);
+    // Interpolate the paths of all the collections, the paths are fitted in parallel.
+    void interpolate_add(tcb::span<const ExtrusionEntityCollection* const> collections, const InterpolationParameters &params);
 
     const Geometry::ArcWelder::Path* resolve(const Polyline      *pl) const;
     const Geometry::ArcWelder::Path* resolve(const ExtrusionPath &path) const;
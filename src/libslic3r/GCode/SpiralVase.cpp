@@ -19,7 +19,7 @@ static AABBTreeLines::LinesDistancer<Linef> get_layer_distancer(const std::vecto
     return AABBTreeLines::LinesDistancer{std::move(lines)};
 }
 
-std::string SpiralVase::process_layer(const std::string &gcode, bool last_layer)
+std::string SpiralVase::process_layer(std::string gcode, bool last_layer)
 {
     /*  This post-processor relies on several assumptions:
         - all layers are processed through it, including those that are not supposed
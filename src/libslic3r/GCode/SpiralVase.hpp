@@ -32,7 +32,8 @@ public:
         m_enabled          = enable;
     }
 
-    std::string process_layer(const std::string &gcode, bool last_layer);
+    // The G-code is taken by value, so that a layer, which is not modified, is passed through without copying.
+    std::string process_layer(std::string gcode, bool last_layer);
 
 private:
     const PrintConfig  &m_config;
@@ -1,7 +1,16 @@
 #include "GCodeReader.hpp"
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/convert.hpp>
 #include <boost/nowide/cstdio.hpp>
 #include <fast_float.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <iomanip>
 #include <cassert>
@@ -22,6 +31,42 @@ static inline char get_extrusion_axis_char(const GCodeConfig &config)
     return axis.empty() ? 0 : axis[0];
 }
 
+// Returns the first '\r' or '\n' character in [c, end), or end if there is none. Zero characters are considered
+// to be ends of lines as well if WithZero is set. Eight characters are tested at a time.
+template<bool WithZero>
+static inline const char* find_end_of_line(const char *c, const char *end)
+{
+    static constexpr const uint64_t ones  = 0x0101010101010101ull;
+    static constexpr const uint64_t highs = 0x8080808080808080ull;
+    auto has_zero_byte = [](uint64_t v) { return ((v - ones) & ~ v & highs) != 0; };
+    for (; end - c >= 8; c += 8) {
+        uint64_t w;
+        memcpy(&w, c, 8);
+        if (has_zero_byte(w ^ (ones * '\n')) || has_zero_byte(w ^ (ones * '\r')) || (WithZero && has_zero_byte(w)))
+            break;
+    }
+    for (; c != end && *c != '\n' && *c != '\r' && (! WithZero || *c != 0); ++ c);
+    return c;
+}
+
+// Memory map a G-code file. An empty file is not mapped, as it cannot be mapped on all platforms.
+static bool map_gcode_file(const std::string &filename, boost::iostreams::mapped_file_source &file)
+{
+    try {
+#ifdef _WIN32
+        const boost::filesystem::path path(boost::nowide::widen(filename));
+#else
+        const boost::filesystem::path path(filename);
+#endif
+        if (boost::filesystem::file_size(path) > 0)
+            file.open(path);
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(error) << "GCodeReader: Couldn't map " << filename << ": " << ex.what();
+        return false;
+    }
+    return true;
+}
+
 void GCodeReader::apply_config(const GCodeConfig &config)
 {
     m_config = config;
@@ -34,10 +79,8 @@ void GCodeReader::apply_config(const DynamicPrintConfig &config)
     m_extrusion_axis = get_extrusion_axis_char(m_config);
 }
 
-const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
+const char* GCodeReader::tokenize_line(const char *ptr, const char *end, float *axis_values, uint32_t &mask, std::pair<const char*, const char*> &command) const
 {
-    assert(is_decimal_separator_point());
-    
     // command and args
     const char *c = ptr;
     {
@@ -75,8 +118,8 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
                 if (pend != c && is_end_of_word(*pend)) {
                     // The axis value has been parsed correctly.
                     if (axis != UNKNOWN_AXIS)
-	                    gline.m_axis[int(axis)] = float(v);
-                    gline.m_mask |= 1 << int(axis);
+	                    axis_values[int(axis)] = float(v);
+                    mask |= 1 << int(axis);
                     c = pend;
                 } else
                     // Skip the rest of the word.
@@ -86,13 +129,20 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
                 c = skip_word(c);
         }
     }
+
+    // Skip the rest of the line.
+    return find_end_of_line<true>(c, end);
+}
+
+const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
+{
+    assert(is_decimal_separator_point());
     
+    const char *c = this->tokenize_line(ptr, end, gline.m_axis, gline.m_mask, command);
+
     if (gline.has(E) && m_config.use_relative_e_distances)
         m_position[E] = 0;
 
-    // Skip the rest of the line.
-    for (; ! is_end_of_line(*c); ++ c);
-
     // Copy the raw string including the comment, without the trailing newlines.
     if (c > ptr)
         gline.m_raw.assign(ptr, c);
@@ -125,62 +175,43 @@ void GCodeReader::update_coordinates(GCodeLine &gline, std::pair<const char*, co
 template<typename ParseLineCallback, typename LineEndCallback>
 bool GCodeReader::parse_file_raw_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback)
 {
-    FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
-
-    fseek(in.f, 0, SEEK_END);
-    const long file_size = ftell(in.f);
-    rewind(in.f);
-
-    // Read the input stream 64kB at a time, extract lines and process them.
-    std::vector<char> buffer(65536 * 10, 0);
-    // Line buffer.
-    std::string gcode_line;
-    size_t file_pos = 0;
+    boost::iostreams::mapped_file_source file;
+    if (! map_gcode_file(filename, file))
+        return false;
+
+    const size_t file_size = file.is_open() ? file.size() : 0;
+    const char  *begin     = file.is_open() ? file.data() : nullptr;
+    const char  *end       = begin + file_size;
+    // Report progress every 640kB.
+    static constexpr const size_t progress_step = 65536 * 10;
+    size_t next_progress = progress_step;
+    // Copy of the last line, if it is not terminated by a newline.
+    std::string last_line;
     m_parsing = true;
-    for (;;) {
-        size_t cnt_read = ::fread(buffer.data(), 1, buffer.size(), in.f);
-        if (::ferror(in.f))
-            return false;
-
-        bool eof       = cnt_read == 0;
-        auto it        = buffer.begin();
-        auto it_bufend = buffer.begin() + cnt_read;
-        while (it != it_bufend || (eof && ! gcode_line.empty())) {
-            // Find end of line.
-            bool eol    = false;
-            auto it_end = it;
-            for (; it_end != it_bufend && ! (eol = *it_end == '\r' || *it_end == '\n'); ++ it_end)
-                if (*it_end == '\n')
-                    line_end_callback(file_pos + (it_end - buffer.begin()) + 1);
-            // End of line is indicated also if end of file was reached.
-            eol |= eof && it_end == it_bufend;
-            if (eol) {
-                if (gcode_line.empty())
-                    parse_line_callback(&(*it), &(*it_end));
-                else {
-                    gcode_line.insert(gcode_line.end(), it, it_end);
-                    parse_line_callback(gcode_line.c_str(), gcode_line.c_str() + gcode_line.size());
-                    gcode_line.clear();
-                }
-                if (! m_parsing)
-                    // The callback wishes to exit.
-                    return true;
-            } else
-                gcode_line.insert(gcode_line.end(), it, it_end);
-            // Skip EOL.
-            it = it_end; 
-            if (it != it_bufend && *it == '\r')
-                ++ it;
-            if (it != it_bufend && *it == '\n') {
-                line_end_callback(file_pos + (it - buffer.begin()) + 1);
-                ++ it;
-            }
+    for (const char *it = begin; it != end;) {
+        // Find end of line.
+        const char *it_end = find_end_of_line<false>(it, end);
+        if (it_end == end) {
+            // The parser expects the line to be terminated.
+            last_line.assign(it, it_end);
+            parse_line_callback(last_line.c_str(), last_line.c_str() + last_line.size());
+        } else
+            parse_line_callback(it, it_end);
+        if (! m_parsing)
+            // The callback wishes to exit.
+            return true;
+        // Skip EOL.
+        it = it_end;
+        if (it != end && *it == '\r')
+            ++ it;
+        if (it != end && *it == '\n') {
+            line_end_callback(size_t(it - begin) + 1);
+            ++ it;
+        }
+        if (m_progress_callback != nullptr && size_t(it - begin) >= next_progress) {
+            m_progress_callback(static_cast<float>(it - begin) / static_cast<float>(file_size));
+            next_progress += progress_step;
         }
-        if (eof)
-            break;
-        file_pos += cnt_read;
-        if (m_progress_callback != nullptr)
-            m_progress_callback(static_cast<float>(file_pos) / static_cast<float>(file_size));
     }
     return true;
 }
@@ -216,6 +247,177 @@ bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_
         [](size_t){});
 }
 
+struct GCodeReader::TokenizedChunk
+{
+    // Line of the chunk, the offsets are relative to the beginning of the chunk text.
+    struct Line
+    {
+        uint32_t begin { 0 };
+        uint32_t end { 0 };
+        uint32_t cmd_begin { 0 };
+        uint32_t cmd_end { 0 };
+        uint32_t mask { 0 };
+        float    axis[NUM_AXES] { 0.f };
+    };
+
+    // Complete lines, either owned by the chunk or referencing memory, which outlives the parsing.
+    std::string         storage;
+    std::string_view    view;
+    // Position of the beginning of the text in the parsed stream.
+    size_t              pos { 0 };
+    std::vector<Line>   lines;
+    // Positions of the ends of lines in the parsed stream, in the same format as produced by parse_file().
+    std::vector<size_t> lines_ends;
+
+    std::string_view    text() const { return storage.empty() ? view : std::string_view(storage); }
+};
+
+void GCodeReader::tokenize_chunk(TokenizedChunk &chunk) const
+{
+    // A G-code line has about 20 characters on average.
+    const std::string_view text = chunk.text();
+    chunk.lines.reserve(text.size() / 16);
+    const char *begin = text.data();
+    const char *end   = begin + text.size();
+    std::pair<const char*, const char*> command;
+    for (const char *ptr = begin; ptr != end;) {
+        TokenizedChunk::Line &line = chunk.lines.emplace_back();
+        const char *c = this->tokenize_line(ptr, end, line.axis, line.mask, command);
+        line.begin     = uint32_t(ptr - begin);
+        line.end       = uint32_t(c - begin);
+        line.cmd_begin = uint32_t(command.first - begin);
+        line.cmd_end   = uint32_t(command.second - begin);
+        // Ignore the rest of a line containing a zero character, as parse_file() does.
+        c = find_end_of_line<false>(c, end);
+        // Skip the trailing newlines.
+        if (c != end && *c == '\r')
+            ++ c;
+        if (c != end && *c == '\n') {
+            ++ c;
+            chunk.lines_ends.emplace_back(chunk.pos + (c - begin));
+        }
+        ptr = c;
+    }
+}
+
+bool GCodeReader::process_tokenized_chunk(const TokenizedChunk &chunk, GCodeLine &gline, callback_t &callback)
+{
+    const char *text = chunk.text().data();
+    for (const TokenizedChunk::Line &line : chunk.lines) {
+        gline.m_raw.assign(text + line.begin, text + line.end);
+        memcpy(gline.m_axis, line.axis, sizeof(gline.m_axis));
+        gline.m_mask = line.mask;
+        if (gline.has(E) && m_config.use_relative_e_distances)
+            m_position[E] = 0;
+        if (m_verbose)
+            std::cout << gline.m_raw << std::endl;
+        callback(*this, gline);
+        std::pair<const char*, const char*> command(text + line.cmd_begin, text + line.cmd_end);
+        this->update_coordinates(gline, command);
+        if (! m_parsing)
+            return false;
+    }
+    return true;
+}
+
+void GCodeReader::parse_parallel(chunk_source_t source, callback_t callback, std::vector<size_t> *lines_ends)
+{
+    // The source and the callback are only called by the calling thread, as they may report progress to the UI.
+    // A batch of chunks is tokenized in parallel in the background, while the previous batch is being processed.
+    const size_t batch_size  = size_t(std::max(2, tbb::this_task_arena::max_concurrency()));
+    size_t       pos         = 0;
+    bool         source_done = false;
+    auto read_batch = [&source, batch_size, &pos, &source_done](std::vector<TokenizedChunk> &batch) {
+        batch.clear();
+        while (! source_done && batch.size() < batch_size) {
+            TokenizedChunk chunk;
+            if (! source(chunk.storage, chunk.view))
+                source_done = true;
+            else {
+                chunk.pos = pos;
+                pos += chunk.text().size();
+                batch.emplace_back(std::move(chunk));
+            }
+        }
+    };
+    auto tokenize_batch = [this](std::vector<TokenizedChunk> &batch) {
+        tbb::parallel_for(size_t(0), batch.size(), [this, &batch](size_t i) { this->tokenize_chunk(batch[i]); });
+    };
+
+    std::vector<TokenizedChunk> batch;
+    std::vector<TokenizedChunk> next_batch;
+    read_batch(batch);
+    tokenize_batch(batch);
+    GCodeLine gline;
+    m_parsing = true;
+    while (! batch.empty()) {
+        read_batch(next_batch);
+        tbb::task_group tokenizer;
+        tokenizer.run([&tokenize_batch, &next_batch]() { tokenize_batch(next_batch); });
+        bool stop = false;
+        try {
+            for (const TokenizedChunk &chunk : batch) {
+                if (lines_ends != nullptr)
+                    lines_ends->insert(lines_ends->end(), chunk.lines_ends.begin(), chunk.lines_ends.end());
+                if (! this->process_tokenized_chunk(chunk, gline, callback)) {
+                    stop = true;
+                    break;
+                }
+            }
+        } catch (...) {
+            tokenizer.wait();
+            throw;
+        }
+        tokenizer.wait();
+        if (stop)
+            break;
+        batch.swap(next_batch);
+    }
+}
+
+bool GCodeReader::parse_file_parallel(const std::string &file, callback_t callback)
+{
+    return this->parse_file_parallel_internal(file, callback, nullptr);
+}
+
+bool GCodeReader::parse_file_parallel(const std::string &file, callback_t callback, std::vector<std::vector<size_t>> &lines_ends)
+{
+    lines_ends.clear();
+    lines_ends.push_back(std::vector<size_t>());
+    return this->parse_file_parallel_internal(file, callback, &lines_ends.front());
+}
+
+bool GCodeReader::parse_file_parallel_internal(const std::string &filename, callback_t callback, std::vector<size_t> *lines_ends)
+{
+    boost::iostreams::mapped_file_source file;
+    if (! map_gcode_file(filename, file))
+        return false;
+
+    // Pass the mapped file to the parser by chunks of complete lines of about 1MB.
+    static constexpr const size_t chunk_size = 1024 * 1024;
+    const std::string_view data = file.is_open() ? std::string_view(file.data(), file.size()) : std::string_view();
+    size_t file_pos = 0;
+    this->parse_parallel([this, &data, &file_pos](std::string &storage, std::string_view &view) {
+        if (file_pos == data.size())
+            return false;
+        size_t chunk_end = data.size();
+        if (file_pos + chunk_size < data.size()) {
+            const size_t eol = data.find('\n', file_pos + chunk_size);
+            if (eol != std::string_view::npos)
+                chunk_end = eol + 1;
+        }
+        view = data.substr(file_pos, chunk_end - file_pos);
+        if (chunk_end == data.size() && data.back() != '\n')
+            // The parser expects the last line to be terminated.
+            storage.assign(view.begin(), view.end());
+        file_pos = chunk_end;
+        if (m_progress_callback != nullptr)
+            m_progress_callback(static_cast<float>(file_pos) / static_cast<float>(data.size()));
+        return true;
+    }, callback, lines_ends);
+    return true;
+}
+
 const char* GCodeReader::axis_pos(const char *raw_str, char axis)
 {
     const char *c = raw_str;
@@ -275,12 +477,22 @@ bool GCodeReader::GCodeLine::has_value(char axis, float &value) const
 bool GCodeReader::GCodeLine::has_value(std::string_view axis_pos, int &value)
 {
     if (const char *c = axis_pos.data(); c) {
-        // Try to parse the numeric value.
-        char   *pend = nullptr;
-        long    v = strtol(++ c, &pend, 10);
-        if (pend != nullptr && is_end_of_word(*pend)) {
+        // Try to parse the numeric value. Leading whitespaces and a plus sign are accepted, as strtol() does.
+        const char *end   = axis_pos.data() + axis_pos.size();
+        const char *begin = ++ c;
+        c = skip_whitespaces(c);
+        if (c != end && *c == '+')
+            ++ c;
+        int v = 0;
+        auto [pend, ec] = std::from_chars(c, end, v);
+        if (ec == std::errc::invalid_argument)
+            // No number at all, which strtol() reports as zero.
+            pend = begin;
+        else if (ec != std::errc())
+            return false;
+        if (pend == end || is_end_of_word(*pend)) {
             // The axis value has been parsed correctly.
-            value = int(v);
+            value = v;
             return true;
         }
     }
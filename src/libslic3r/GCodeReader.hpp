@@ -149,6 +149,20 @@ public:
     bool parse_file(const std::string& file, callback_t callback, std::vector<std::vector<size_t>>& lines_ends);
     // Just read the G-code file line by line, calls callback (const char *begin, const char *end). Returns false if reading the file failed.
     bool parse_file_raw(const std::string &file, raw_line_callback_t callback);
+    // Provides the next chunk of complete lines to be parsed by parse_parallel(), returns false if there are no more chunks.
+    // The chunk is either moved into the string (first parameter) or referenced by the string_view (second parameter),
+    // in which case the memory has to stay valid until parse_parallel() returns. Only the last line of the last chunk
+    // may be left without a newline, and only if the chunk is zero terminated, thus passed as a string.
+    typedef std::function<bool(std::string&, std::string_view&)> chunk_source_t;
+    // Two phase parsing for large G-codes: The chunks of lines are tokenized in parallel into a compact buffer of commands
+    // and axis values, then the callback is called sequentially on the lines in their order with the coordinates of this
+    // reader updated, thus the callback sees the same sequence of lines as with parse_buffer() called on each chunk.
+    // Both the source and the callback are called from the calling thread only.
+    // If lines_ends is provided, positions of the line ends relative to the beginning of the first chunk are appended to it.
+    void parse_parallel(chunk_source_t source, callback_t callback, std::vector<size_t> *lines_ends = nullptr);
+    // parse_file() implemented with parse_parallel().
+    bool parse_file_parallel(const std::string &file, callback_t callback);
+    bool parse_file_parallel(const std::string &file, callback_t callback, std::vector<std::vector<size_t>> &lines_ends);
 
     // To be called by the callback to stop parsing.
     void quit_parsing() { m_parsing = false; }
@@ -177,8 +191,16 @@ private:
     bool        parse_file_raw_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
     template<typename ParseLineCallback, typename LineEndCallback>
     bool        parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
+    bool        parse_file_parallel_internal(const std::string &filename, callback_t callback, std::vector<size_t> *lines_ends);
 
     const char* parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    // Parse the command and the axes of a single line, returns the end of the line without the trailing newlines.
+    // Does not modify the state of the reader, thus it may be called in parallel.
+    const char* tokenize_line(const char *ptr, const char *end, float *axis, uint32_t &mask, std::pair<const char*, const char*> &command) const;
+    struct TokenizedChunk;
+    void        tokenize_chunk(TokenizedChunk &chunk) const;
+    // Returns false if the callback stopped the parsing.
+    bool        process_tokenized_chunk(const TokenizedChunk &chunk, GCodeLine &gline, callback_t &callback);
     void        update_coordinates(GCodeLine &gline, std::pair<const char*, const char*> &command);
 
     static bool         is_whitespace(char c)           { return c == ' ' || c == '\t'; }
@@ -13,6 +13,7 @@
 #include <cinttypes>
 #include <cstddef>
 
+#include "AABBTreeLines.hpp"
 #include "Line.hpp"
 #include "libslic3r.h"
 #include "BoundingBox.hpp"
@@ -183,6 +184,9 @@ public:
     ExPolygons 				lslices;
     std::vector<size_t>     lslice_indices_sorted_by_print_order;
     LayerSlices             lslices_ex;
+    // Unscaled edges of lslices indexed by an AABB tree for distance queries to the layer outline, shared by the estimation
+    // of curled extrusions, the overhanging perimeters and the support spots search. Built together with the perimeters.
+    const AABBTreeLines::LinesDistancer<Linef>& lslices_distancer() const { return m_lslices_distancer; }
 
     size_t                  region_count() const { return m_regions.size(); }
     const LayerRegion*      get_region(int idx) const { return m_regions[idx]; }
@@ -245,6 +249,8 @@ protected:
     virtual ~Layer();
     // Clear fill extrusions, remove them from layer islands.
     void clear_fills();
+    // To be called once the lslices are final.
+    void build_lslices_distancer() { m_lslices_distancer = AABBTreeLines::LinesDistancer<Linef>{ to_unscaled_linesf(this->lslices) }; }
 
 private:
     void sort_perimeters_into_islands(
@@ -267,6 +273,7 @@ private:
     size_t              m_id;
     PrintObject        *m_object;
     LayerRegionPtrs     m_regions;
+    AABBTreeLines::LinesDistancer<Linef> m_lslices_distancer;
 };
 
 class SupportLayer : public Layer 
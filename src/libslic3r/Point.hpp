@@ -21,6 +21,7 @@
 
 #include "libslic3r.h"
 #include "LocalesUtils.hpp"
+#include "PointsArena.hpp"
 #include "libslic3r/Point.hpp"
 
 namespace Slic3r {
@@ -60,9 +61,15 @@ using Vec2d   = Eigen::Matrix<double,   2, 1, Eigen::DontAlign>;
 using Vec3d   = Eigen::Matrix<double,   3, 1, Eigen::DontAlign>;
 using Vec4d   = Eigen::Matrix<double,   4, 1, Eigen::DontAlign>;
 
+#ifdef SLIC3R_POINTS_ARENA
+// Serve Points from the thread local arena of an active PointsArenaScope, see PointsArena.hpp.
+template<typename BaseType>
+using PointsAllocator = PointsArenaAllocator<BaseType>;
+#else // SLIC3R_POINTS_ARENA
 template<typename BaseType>
 using PointsAllocator = tbb::scalable_allocator<BaseType>;
 //using PointsAllocator = std::allocator<BaseType>;
+#endif // SLIC3R_POINTS_ARENA
 using Points         = std::vector<Point, PointsAllocator<Point>>;
 using PointPtrs      = std::vector<Point*>;
 using PointConstPtrs = std::vector<const Point*>;
@@ -0,0 +1,205 @@
+#include "PointsArena.hpp"
+
+#ifdef SLIC3R_POINTS_ARENA
+#include <oneapi/tbb/enumerable_thread_specific.h>
+#include <oneapi/tbb/scalable_allocator.h>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <new>
+#endif // SLIC3R_POINTS_ARENA
+
+namespace Slic3r {
+
+#ifdef SLIC3R_POINTS_ARENA
+
+namespace {
+
+// Chunk of an arena. The allocations follow the chunk header.
+struct alignas(16) PointsArenaChunk
+{
+    // Bias added to the reference count while the arena allocates from this chunk,
+    // so that the arena does not need to touch the atomic counter on each allocation.
+    static constexpr size_t BIAS = std::numeric_limits<size_t>::max() / 2;
+
+    std::atomic<size_t> refs { BIAS };
+};
+
+// Each allocation is prefixed by a header pointing to its chunk, nullptr for allocations served by scalable_malloc().
+struct alignas(16) AllocationHeader
+{
+    PointsArenaChunk *chunk;
+};
+
+static constexpr size_t ARENA_CHUNK_SIZE     = 64 * 1024;
+static constexpr size_t ARENA_ALIGNMENT      = 16;
+// Larger allocations are served by scalable_malloc() to keep the chunks dense.
+static constexpr size_t MAX_ARENA_ALLOCATION = ARENA_CHUNK_SIZE / 8;
+
+static_assert(sizeof(PointsArenaChunk) == ARENA_ALIGNMENT);
+static_assert(sizeof(AllocationHeader) == ARENA_ALIGNMENT);
+
+// Allocation counters of a single thread. Only the owning thread updates them, thus there is no contention
+// on the counters, atomics are used just to allow points_allocation_stats() to read them from another thread.
+struct PointsAllocationCounters
+{
+    PointsAllocationCounters() = default;
+    // Required by tbb::enumerable_thread_specific, never called for a counter in use.
+    PointsAllocationCounters(const PointsAllocationCounters&) {}
+
+    static void increment(std::atomic<size_t> &counter) { counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    PointsArena         *arena { nullptr };
+    std::atomic<size_t>  arena_allocations { 0 };
+    std::atomic<size_t>  heap_allocations { 0 };
+    std::atomic<size_t>  chunks { 0 };
+};
+
+static tbb::enumerable_thread_specific<PointsAllocationCounters, tbb::cache_aligned_allocator<PointsAllocationCounters>, tbb::ets_key_per_instance> s_counters;
+
+// Number of chunks allocated and not yet released, updated once per chunk only.
+static std::atomic<size_t> s_chunks_alive { 0 };
+
+static PointsAllocationCounters& thread_counters()
+{
+    static thread_local PointsAllocationCounters *counters = &s_counters.local();
+    return *counters;
+}
+
+static void free_chunk(PointsArenaChunk *chunk)
+{
+    scalable_aligned_free(chunk);
+    s_chunks_alive.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Called by the arena when moving past the chunk.
+static void release_chunk(PointsArenaChunk *chunk, size_t num_allocations)
+{
+    // Convert the biased reference count to the number of live allocations.
+    const size_t bias = PointsArenaChunk::BIAS - num_allocations;
+    if (chunk->refs.fetch_sub(bias, std::memory_order_acq_rel) == bias)
+        free_chunk(chunk);
+}
+
+} // namespace
+
+class PointsArena
+{
+public:
+    PointsArena() = default;
+    ~PointsArena() {
+        if (m_chunk)
+            release_chunk(m_chunk, m_num_allocations);
+    }
+    PointsArena(const PointsArena&) = delete;
+    PointsArena& operator=(const PointsArena&) = delete;
+
+    // size is rounded up to ARENA_ALIGNMENT and includes the allocation header.
+    AllocationHeader* allocate(size_t size) {
+        assert(size <= ARENA_CHUNK_SIZE - sizeof(PointsArenaChunk));
+        if (m_chunk == nullptr || m_used + size > ARENA_CHUNK_SIZE)
+            this->next_chunk();
+        auto *header = reinterpret_cast<AllocationHeader*>(reinterpret_cast<char*>(m_chunk) + m_used);
+        header->chunk = m_chunk;
+        m_used += size;
+        ++ m_num_allocations;
+        return header;
+    }
+
+private:
+    void next_chunk() {
+        if (m_chunk)
+            release_chunk(m_chunk, m_num_allocations);
+        void *mem = scalable_aligned_malloc(ARENA_CHUNK_SIZE, ARENA_ALIGNMENT);
+        if (mem == nullptr)
+            throw std::bad_alloc();
+        m_chunk           = new (mem) PointsArenaChunk();
+        m_used            = sizeof(PointsArenaChunk);
+        m_num_allocations = 0;
+        PointsAllocationCounters::increment(thread_counters().chunks);
+        s_chunks_alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PointsArenaChunk *m_chunk           { nullptr };
+    size_t            m_used            { 0 };
+    size_t            m_num_allocations { 0 };
+};
+
+namespace points_arena {
+
+void* allocate(size_t size)
+{
+    PointsAllocationCounters &counters = thread_counters();
+    size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT + sizeof(AllocationHeader);
+    AllocationHeader *header;
+    if (counters.arena != nullptr && size <= MAX_ARENA_ALLOCATION) {
+        header = counters.arena->allocate(size);
+        PointsAllocationCounters::increment(counters.arena_allocations);
+    } else {
+        header = static_cast<AllocationHeader*>(scalable_aligned_malloc(size, ARENA_ALIGNMENT));
+        if (header == nullptr)
+            throw std::bad_alloc();
+        header->chunk = nullptr;
+        PointsAllocationCounters::increment(counters.heap_allocations);
+    }
+    return header + 1;
+}
+
+void deallocate(void *ptr) noexcept
+{
+    if (ptr == nullptr)
+        return;
+    AllocationHeader *header = static_cast<AllocationHeader*>(ptr) - 1;
+    if (PointsArenaChunk *chunk = header->chunk; chunk == nullptr)
+        scalable_aligned_free(header);
+    else if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        // The arena already moved past this chunk and this was its last live allocation.
+        free_chunk(chunk);
+}
+
+} // namespace points_arena
+
+PointsArenaScope::PointsArenaScope() : m_arena(new PointsArena())
+{
+    PointsAllocationCounters &counters = thread_counters();
+    m_previous     = counters.arena;
+    counters.arena = m_arena;
+}
+
+PointsArenaScope::~PointsArenaScope()
+{
+    PointsAllocationCounters &counters = thread_counters();
+    assert(counters.arena == m_arena);
+    counters.arena = m_previous;
+    delete m_arena;
+}
+
+PointsAllocationStats points_allocation_stats()
+{
+    PointsAllocationStats out;
+    for (const PointsAllocationCounters &counters : s_counters) {
+        out.arena_allocations += counters.arena_allocations.load(std::memory_order_relaxed);
+        out.heap_allocations  += counters.heap_allocations.load(std::memory_order_relaxed);
+        out.chunks            += counters.chunks.load(std::memory_order_relaxed);
+    }
+    out.chunks_alive = s_chunks_alive.load(std::memory_order_relaxed);
+    return out;
+}
+
+void reset_points_allocation_stats()
+{
+    for (PointsAllocationCounters &counters : s_counters) {
+        counters.arena_allocations.store(0, std::memory_order_relaxed);
+        counters.heap_allocations .store(0, std::memory_order_relaxed);
+        counters.chunks           .store(0, std::memory_order_relaxed);
+    }
+}
+
+#else // SLIC3R_POINTS_ARENA
+
+PointsAllocationStats points_allocation_stats() { return {}; }
+void reset_points_allocation_stats() {}
+
+#endif // SLIC3R_POINTS_ARENA
+
+} // namespace Slic3r
@@ -0,0 +1,96 @@
+#ifndef slic3r_PointsArena_hpp_
+#define slic3r_PointsArena_hpp_
+
+#include <cstddef>
+
+namespace Slic3r {
+
+// Opt-in arena allocation of the Points storage of short lived Polygon / Polyline / ExPolygon temporaries,
+// enabled by the SLIC3R_POINTS_ARENA build flag.
+//
+// With the flag enabled, PointsAllocator (and thus ClipperLib::Path, which must stay the same type as Points)
+// is a stateless allocator, which serves allocations from a thread local arena while a PointsArenaScope
+// is active on the current thread, and from tbb::scalable_malloc() otherwise. An arena is a chain of
+// monotonic chunks: An allocation is a pointer bump, a deallocation just decrements the chunk's reference count.
+// A chunk is released once the arena moved past it and all of its allocations were freed, therefore objects
+// escaping the scope stay valid, they just pin their chunk. Open the scope around work producing mostly
+// temporaries, for example around processing of a single layer inside a TBB task.
+//
+// Without the flag PointsArenaScope is a no-op and Points are allocated by tbb::scalable_allocator.
+
+struct PointsAllocationStats
+{
+    // Allocations served by an arena.
+    size_t arena_allocations { 0 };
+    // Allocations served by tbb::scalable_malloc(): Outside of any PointsArenaScope or too large for an arena chunk.
+    size_t heap_allocations  { 0 };
+    // Arena chunks allocated.
+    size_t chunks            { 0 };
+    // Chunks not released yet. Outside of any PointsArenaScope these are the chunks pinned by allocations outliving their scope.
+    // Not affected by reset_points_allocation_stats().
+    size_t chunks_alive      { 0 };
+};
+
+// Sum of the allocation counters of all threads. Always zero if SLIC3R_POINTS_ARENA is not defined.
+PointsAllocationStats points_allocation_stats();
+// Reset the counters. Allocations running in parallel may not be accounted for reliably.
+void                  reset_points_allocation_stats();
+
+#ifdef SLIC3R_POINTS_ARENA
+
+namespace points_arena {
+    void* allocate(size_t size);
+    void  deallocate(void *ptr) noexcept;
+} // namespace points_arena
+
+class PointsArena;
+
+// Serve allocations of Points on the current thread from a fresh arena until the scope is left. Scopes may be nested.
+class PointsArenaScope
+{
+public:
+    PointsArenaScope();
+    ~PointsArenaScope();
+    PointsArenaScope(const PointsArenaScope&) = delete;
+    PointsArenaScope& operator=(const PointsArenaScope&) = delete;
+
+private:
+    PointsArena *m_arena;
+    PointsArena *m_previous;
+};
+
+template<typename T>
+class PointsArenaAllocator
+{
+public:
+    using value_type = T;
+
+    PointsArenaAllocator() noexcept = default;
+    template<typename U>
+    PointsArenaAllocator(const PointsArenaAllocator<U>&) noexcept {}
+
+    T*   allocate(size_t n) { return static_cast<T*>(points_arena::allocate(n * sizeof(T))); }
+    void deallocate(T *ptr, size_t) noexcept { points_arena::deallocate(ptr); }
+
+    // Stateless: Memory allocated by any instance may be released by any other instance.
+    template<typename U>
+    bool operator==(const PointsArenaAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const PointsArenaAllocator<U>&) const noexcept { return false; }
+};
+
+#else // SLIC3R_POINTS_ARENA
+
+class PointsArenaScope
+{
+public:
+    PointsArenaScope() {}
+    PointsArenaScope(const PointsArenaScope&) = delete;
+    PointsArenaScope& operator=(const PointsArenaScope&) = delete;
+};
+
+#endif // SLIC3R_POINTS_ARENA
+
+} // namespace Slic3r
+
+#endif // slic3r_PointsArena_hpp_
@@ -999,7 +999,11 @@ std::string Print::export_gcode(const std::string& path_template, GCodeProcessor
 
     // Create GCode on heap, it has quite a lot of data.
     std::unique_ptr<GCodeGenerator> gcode(new GCodeGenerator(const_cast<const Print*>(this)));
-    gcode->do_export(this, path.c_str(), result, thumbnail_cb);
+    if (! gcode->do_export(this, path.c_str(), result, thumbnail_cb)) {
+        // The G-code could not be written into the local temporary directory, generate it next to the destination.
+        gcode.reset(new GCodeGenerator(const_cast<const Print*>(this)));
+        gcode->do_export(this, path.c_str(), result, thumbnail_cb, false);
+    }
 
     if (m_conflict_result.has_value())
         result->conflict_result = *m_conflict_result;
@@ -22,7 +22,10 @@
 
 #include <Eigen/Geometry>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <tcbspan/span.hpp>
@@ -35,6 +38,7 @@ class ModelObject;
 class Print;
 class PrintObject;
 class SupportLayer;
+class TriangleMesh;
 
 namespace FillAdaptive {
     struct Octree;
@@ -48,6 +52,10 @@ namespace FillLightning {
     using GeneratorPtr = std::unique_ptr<Generator, GeneratorDeleter>;
 }; // namespace FillLightning
 
+namespace FFFTreeSupport {
+    class TreeModelVolumes;
+}; // namespace FFFTreeSupport
+
 // Print step IDs for keeping track of the print state.
 // The Print steps are applied in this order.
 enum PrintStep : unsigned int {
@@ -235,12 +243,40 @@ public:
 
     std::optional<GeneratedSupportPoints> generated_support_points;
 
+    // Raw slices of a ModelVolume produced by the last slicing of a PrintObject sharing this PrintObjectRegions.
+    // PrintObject::slice_volumes() reuses them for the slicing planes, which did not move after the layer height profile
+    // was edited, so that only the modified Z band is sliced again.
+    // A single entry is kept per ModelVolume, it is replaced by the next slicing of the volume.
+    struct VolumeSlices {
+        ObjectID                              volume_id;
+        // Holding the mesh identifies the mesh the slices were produced from.
+        std::shared_ptr<const TriangleMesh>   mesh;
+        MeshSlicingParamsEx                   params;
+        // Sorted slicing planes and their slices.
+        std::vector<float>                    zs;
+        std::vector<ExPolygons>               slices;
+        // Estimate of the memory held by slices.
+        size_t                                memsize   { 0 };
+        // Value of VolumeSlicesCache::timestamp when the entry was last stored or reused.
+        size_t                                last_used { 0 };
+    };
+    struct VolumeSlicesCache {
+        // PrintObjects sharing this PrintObjectRegions are sliced in parallel.
+        std::mutex                            mutex;
+        std::vector<VolumeSlices>             volumes;
+        // Least recently used entries are dropped once the slices of all entries take more memory than max_memsize.
+        size_t                                max_memsize { size_t(256) * 1024 * 1024 };
+        size_t                                timestamp   { 0 };
+    };
+    VolumeSlicesCache                           cached_volume_slices;
+
     void ref_cnt_inc() { ++ m_ref_cnt; }
     void ref_cnt_dec() { if (-- m_ref_cnt == 0) delete this; }
     void clear() {
         all_regions.clear();
         layer_ranges.clear();
         cached_volume_ids.clear();
+        cached_volume_slices.volumes.clear();
     }
 
 private:
@@ -310,6 +346,9 @@ public:
     void            clear_support_layers();
     SupportLayer*   get_support_layer(int idx) { return m_support_layers[idx]; }
     SupportLayer*   add_support_layer(int id, int interface_id, coordf_t height, coordf_t print_z);
+    // Collision and avoidance areas of the tree supports, kept between the support generations of this object
+    // to be reused if only the support parameters not affecting them were modified. Released when the slices are invalidated.
+    std::shared_ptr<FFFTreeSupport::TreeModelVolumes>& tree_model_volumes_cache() { return m_tree_model_volumes; }
     SupportLayerPtrs::iterator insert_support_layer(SupportLayerPtrs::iterator pos, size_t id, size_t interface_id, coordf_t height, coordf_t print_z, coordf_t slice_z);
     void            delete_support_layer(int idx);
     
@@ -376,6 +415,14 @@ private:
     // It may be called for both the PrintObjectConfig and PrintRegionConfig.
     bool                    invalidate_state_by_config_options(
         const ConfigOptionResolver &old_config, const ConfigOptionResolver &new_config, const std::vector<t_config_option_key> &opt_keys);
+    // Invalidate steps based on a set of parameters changed for a PrintRegion of a single layer range.
+    // If possible, only the perimeters, infill and ironing of the layers around the layer range will be regenerated.
+    bool                    invalidate_layer_range_by_config_options(
+        const PrintRegionConfig &old_config, const PrintRegionConfig &new_config, const std::vector<t_config_option_key> &opt_keys,
+        const t_layer_height_range &layer_range);
+    // Invalidate the slicing after the layer height profile of the ModelObject was edited.
+    // If possible, the layers keeping their Z are kept by the next slicing together with their perimeters and infill.
+    bool                    invalidate_layer_height_profile();
     // If ! m_slicing_params.valid, recalculate.
     void                    update_slicing_parameters();
 
@@ -385,6 +432,14 @@ private:
     static PrintObjectConfig object_config_from_model_object(const PrintObjectConfig &default_object_config, const ModelObject &object, size_t num_extruders);
 
 private:
+    // Span of layers to be processed by the per layer steps (perimeters, infill, ironing), clamped to the number of layers.
+    std::pair<size_t, size_t> invalid_layers() const
+        { return { std::min(m_invalid_layers.first, m_layers.size()), std::min(m_invalid_layers.second, m_layers.size()) }; }
+    bool                      per_layer_steps_done() const;
+    std::pair<size_t, size_t> layers_depending_on(size_t layers_begin, size_t layers_end,
+        const PrintRegionConfig *old_config = nullptr, const PrintRegionConfig *new_config = nullptr) const;
+    void                      invalidate_layers(const std::pair<size_t, size_t> &layers, bool layers_done, const std::pair<size_t, size_t> &invalid_layers_old);
+
     void make_perimeters();
     void prepare_infill();
     void clear_fills();
@@ -395,7 +450,7 @@ private:
     void estimate_curled_extrusions();
     void calculate_overhanging_perimeters();
 
-    void slice_volumes();
+    void slice_volumes(size_t layers_begin, size_t layers_end);
     // Has any support (not counting the raft).
     //w12
     ExPolygons _shrink_contour_holes(double contour_delta, double hole_delta, const ExPolygons &polys) const;
@@ -434,8 +489,16 @@ private:
     // so that next call to make_perimeters() performs a union() before computing loops
     bool                    				m_typed_slices = false;
 
+    // Span of layers [first, second), whose perimeters, infill and ironing are to be regenerated by the invalidated per layer steps.
+    // All layers, unless a config change of a single layer range was the only invalidation since the per layer steps finished,
+    // see invalidate_layer_range_by_config_options().
+    std::pair<size_t, size_t>               m_invalid_layers { 0, std::numeric_limits<size_t>::max() };
+    // Set by invalidate_layer_height_profile(): The next slice() keeps the layers, which did not change their Z.
+    bool                                    m_keep_unchanged_layers { false };
+
     std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> m_adaptive_fill_octrees;
     FillLightning::GeneratorPtr m_lightning_generator;
+    std::shared_ptr<FFFTreeSupport::TreeModelVolumes> m_tree_model_volumes;
 };
 
 
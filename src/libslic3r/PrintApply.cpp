@@ -633,6 +633,12 @@ void print_objects_regions_invalidate_keep_some_volumes(PrintObjectRegions &prin
             }
         }
     print_object_regions.cached_volume_ids.erase(print_object_regions.cached_volume_ids.begin() + last_cached_volume, print_object_regions.cached_volume_ids.end());
+
+    // Release the cached slices of the volumes, which were removed or transformed.
+    auto &cached_slices = print_object_regions.cached_volume_slices.volumes;
+    cached_slices.erase(std::remove_if(cached_slices.begin(), cached_slices.end(), [&print_object_regions](const PrintObjectRegions::VolumeSlices &vs) {
+            return ! std::binary_search(print_object_regions.cached_volume_ids.begin(), print_object_regions.cached_volume_ids.end(), vs.volume_id);
+        }), cached_slices.end());
 }
 
 // Find a bounding box of a volume's part intersecting layer_range. Such a bounding box will likely be smaller in XY than the full bounding box,
@@ -680,7 +686,7 @@ bool verify_update_print_object_regions(
     const PrintRegionConfig            &default_region_config,
     size_t                              num_extruders,
     PrintObjectRegions                 &print_object_regions,
-    const std::function<void(const PrintRegionConfig&, const PrintRegionConfig&, const t_config_option_keys&)> &callback_invalidate)
+    const std::function<void(const PrintRegionConfig&, const PrintRegionConfig&, const t_config_option_keys&, const t_layer_height_range&)> &callback_invalidate)
 {
     // Sort by ModelVolume ID.
     model_volumes_sort_by_id(model_volumes);
@@ -688,6 +694,33 @@ bool verify_update_print_object_regions(
     for (std::unique_ptr<PrintRegion> &region : print_object_regions.all_regions)
         print_region_ref_reset(*region);
 
+    // PrintRegions modified by this call with their original configs. A modified PrintRegion may be shared by multiple layer ranges
+    // if it was modified the same way for all of them, then all these layer ranges need to be invalidated.
+    std::vector<std::pair<const PrintRegion*, PrintRegionConfig>> modified_regions;
+    // Returns false if the region is being split, thus the object needs to be resliced.
+    auto update_region = [&modified_regions, &callback_invalidate](PrintRegion &region, const PrintRegionConfig &cfg, const t_layer_height_range &layer_height_range) {
+        if (cfg != region.config()) {
+            // Region configuration changed.
+            if (print_region_ref_cnt(region) == 0) {
+                // Region is referenced for the first time. Just change its parameters.
+                // Stop the background process before assigning new configuration to the regions.
+                t_config_option_keys diff = region.config().diff(cfg);
+                callback_invalidate(region.config(), cfg, diff, layer_height_range);
+                modified_regions.emplace_back(&region, region.config());
+                region.config_apply_only(cfg, diff, false);
+            } else {
+                // Region is referenced multiple times, thus the region is being split. We need to reslice.
+                return false;
+            }
+        } else if (auto it = std::find_if(modified_regions.begin(), modified_regions.end(), [&region](const auto &r){ return r.first == &region; });
+                   it != modified_regions.end()) {
+            // Region was modified by another layer range sharing it.
+            callback_invalidate(it->second, cfg, it->second.diff(cfg), layer_height_range);
+        }
+        print_region_ref_inc(region);
+        return true;
+    };
+
     // Verify and / or update PrintRegions produced by ModelVolumes, layer range modifiers, modifier volumes.
     for (PrintObjectRegions::LayerRangeRegions &layer_range : print_object_regions.layer_ranges) {
         // Each modifier ModelVolume intersecting this layer_range shall be referenced here at least once if it intersects some
@@ -735,20 +768,8 @@ bool verify_update_print_object_regions(
                 PrintRegionConfig cfg = region.parent == -1 ?
                     region_config_from_model_volume(default_region_config, layer_range.config, **it_model_volume, num_extruders) :
                     region_config_from_model_volume(layer_range.volume_regions[region.parent].region->config(), nullptr, **it_model_volume, num_extruders);
-                if (cfg != region.region->config()) {
-                    // Region configuration changed.
-                    if (print_region_ref_cnt(*region.region) == 0) {
-                        // Region is referenced for the first time. Just change its parameters.
-                        // Stop the background process before assigning new configuration to the regions.
-                        t_config_option_keys diff = region.region->config().diff(cfg);
-                        callback_invalidate(region.region->config(), cfg, diff);
-                        region.region->config_apply_only(cfg, diff, false);
-                    } else {
-                        // Region is referenced multiple times, thus the region is being split. We need to reslice.
-                        return false;
-                    }
-                }
-                print_region_ref_inc(*region.region);
+                if (! update_region(*region.region, cfg, layer_range.layer_height_range))
+                    return false;
             }
     }
 
@@ -760,20 +781,8 @@ bool verify_update_print_object_regions(
             cfg.perimeter_extruder.value    = region.extruder_id;
             cfg.solid_infill_extruder.value = region.extruder_id;
             cfg.infill_extruder.value       = region.extruder_id;
-            if (cfg != region.region->config()) {
-                // Region configuration changed.
-                if (print_region_ref_cnt(*region.region) == 0) {
-                    // Region is referenced for the first time. Just change its parameters.
-                    // Stop the background process before assigning new configuration to the regions.
-                    t_config_option_keys diff = region.region->config().diff(cfg);
-                    callback_invalidate(region.region->config(), cfg, diff);
-                    region.region->config_apply_only(cfg, diff, false);
-                } else {
-                    // Region is referenced multiple times, thus the region is being split. We need to reslice.
-                    return false;
-                }
-            }
-            print_region_ref_inc(*region.region);
+            if (! update_region(*region.region, cfg, layer_range.layer_height_range))
+                return false;
         }
 
     // Verify and / or update PrintRegions produced by fuzzy skin painting.
@@ -782,20 +791,8 @@ bool verify_update_print_object_regions(
             const PrintRegion &parent_print_region = *region.parent_print_object_region(layer_range);
             PrintRegionConfig  cfg                 = parent_print_region.config();
             cfg.fuzzy_skin.value                   = FuzzySkinType::All;
-            if (cfg != region.region->config()) {
-                // Region configuration changed.
-                if (print_region_ref_cnt(*region.region) == 0) {
-                    // Region is referenced for the first time. Just change its parameters.
-                    // Stop the background process before assigning new configuration to the regions.
-                    t_config_option_keys diff = region.region->config().diff(cfg);
-                    callback_invalidate(region.region->config(), cfg, diff);
-                    region.region->config_apply_only(cfg, diff, false);
-                } else {
-                    // Region is referenced multiple times, thus the region is being split. We need to reslice.
-                    return false;
-                }
-            }
-            print_region_ref_inc(*region.region);
+            if (! update_region(*region.region, cfg, layer_range.layer_height_range))
+                return false;
         }
     }
 
@@ -1284,8 +1281,11 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             model_object_status.print_object_regions = print_objects_range.begin()->print_object->m_shared_regions;
             model_object_status.print_object_regions->ref_cnt_inc();
         }
-        if (solid_or_modifier_differ || model_origin_translation_differ || layer_height_ranges_differ ||
-            ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile)) {
+        bool layer_height_profile_differs = ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile);
+        // Only the layer height profile was edited, the PrintObjects will keep the layers, which do not change their Z.
+        bool layer_height_profile_only  = layer_height_profile_differs && ! solid_or_modifier_differ && ! model_origin_translation_differ &&
+                                          ! layer_height_ranges_differ && model_object_status.print_object_regions != nullptr;
+        if (! layer_height_profile_only && (solid_or_modifier_differ || model_origin_translation_differ || layer_height_ranges_differ || layer_height_profile_differs)) {
             // The very first step (the slicing step) is invalidated. One may freely remove all associated PrintObjects.
             model_object_status.print_object_regions_status = 
                 model_object_status.print_object_regions == nullptr || model_origin_translation_differ || layer_height_ranges_differ ?
@@ -1306,6 +1306,14 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             model_object.assign_copy(model_object_new);
         } else {
             model_object_status.print_object_regions_status = ModelObjectStatus::PrintObjectRegionsStatus::Valid;
+            if (layer_height_profile_only) {
+                // First stop background processing before modifying the layer height profile, which is read by the slicing.
+                this->call_cancel_callback();
+                update_apply_status(false);
+                model_object.layer_height_profile.assign(model_object_new.layer_height_profile);
+                for (const PrintObjectStatus &print_object_status : print_objects_range)
+                    update_apply_status(print_object_status.print_object->invalidate_layer_height_profile());
+            }
             if (supports_differ || model_custom_supports_data_changed(model_object, model_object_new)) {
                 // First stop background processing before shuffling or deleting the ModelVolumes in the ModelObject's list.
                 if (supports_differ) {
@@ -1528,10 +1536,10 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                     m_default_region_config,
                     num_extruders,
                     *print_object_regions,
-                    [it_print_object, it_print_object_end, &update_apply_status](const PrintRegionConfig &old_config, const PrintRegionConfig &new_config, const t_config_option_keys &diff_keys) {
+                    [it_print_object, it_print_object_end, &update_apply_status](const PrintRegionConfig &old_config, const PrintRegionConfig &new_config, const t_config_option_keys &diff_keys, const t_layer_height_range &layer_range) {
                         for (auto it = it_print_object; it != it_print_object_end; ++it)
                             if ((*it)->m_shared_regions != nullptr)
-                                update_apply_status((*it)->invalidate_state_by_config_options(old_config, new_config, diff_keys));
+                                update_apply_status((*it)->invalidate_layer_range_by_config_options(old_config, new_config, diff_keys, layer_range));
                     })) {
                 // Regions are valid, just keep them.
             } else {
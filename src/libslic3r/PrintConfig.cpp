@@ -172,6 +172,12 @@ static const t_config_enum_values s_keys_map_SupportMaterialInterfacePattern {
 };
 CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(SupportMaterialInterfacePattern)
 
+static const t_config_enum_values s_keys_map_SupportTreeCollisionMode {
+    { "polygons",       stcmPolygons },
+    { "distance_field", stcmDistanceField }
+};
+CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(SupportTreeCollisionMode)
+
 static const t_config_enum_values s_keys_map_SeamPosition {
     { "random",         spRandom },
     { "nearest",        spNearest },
@@ -3800,6 +3806,21 @@ void PrintConfigDef::init_fff_params()
     def->mode = comAdvanced;
     def->set_default_value(new ConfigOptionPercent(15));
 
+    def = this->add("support_tree_collision_mode", coEnum);
+    def->label = L("Branch collision detection");
+    def->category = L("Support material");
+    // TRN PrintSettings: "Organic supports" > "Branch collision detection"
+    def->tooltip = L("How the branches of organic supports are tested for collisions with the object when they are being smoothed. "
+                     "Polygons test the branches against the outlines of the object exactly. "
+                     "Distance field samples the distance to the outlines of the object on a grid, which is faster "
+                     "for large numbers of branches, at the cost of additional memory and a slightly lower precision.");
+    def->set_enum<SupportTreeCollisionMode>({
+        { "polygons",       L("Polygons") },
+        { "distance_field", L("Distance field") }
+    });
+    def->mode = comExpert;
+    def->set_default_value(new ConfigOptionEnum<SupportTreeCollisionMode>(stcmPolygons));
+
     def = this->add("temperature", coInts);
     def->label = L("Other layers");
     def->tooltip = L("Nozzle temperature for layers after the first one. Set this to zero to disable "
@@ -6099,6 +6120,15 @@ CLIActionsConfigDef::CLIActionsConfigDef()
     def->cli = "gcodeviewer";
     def->set_default_value(new ConfigOptionBool(false));
 
+    // needs *.gcode files or directories containing them
+
+    def = this->add("estimate_time", coBool);
+    def->label = L("Estimate print time");
+    def->tooltip = L("Estimate print time and filament usage of the input G-code files and of the G-code files found in the input directories. "
+                     "The estimates are printed out as JSON, use 'output' option to write them into a file.");
+    def->cli = "estimate-time";
+    def->set_default_value(new ConfigOptionBool(false));
+
     // needs a configuration input
 
     def = this->add("save", coString);
@@ -6256,6 +6286,20 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->label = L("Data directory");
     def->tooltip = L("Load and store settings at the given directory. This is useful for maintaining different profiles or including configurations from a network storage.");
 
+    def = this->add("slice_cache", coString);
+    def->label = L("Slice cache directory");
+    def->tooltip = L("Store sliced layers of the objects into the given directory and reuse them when the same mesh is sliced again "
+                     "with the same transformation and layer heights. This speeds up repeated slicing of the same models, "
+                     "when only G-code related settings are changed.");
+
+    def = this->add("slice_cache_size", coInt);
+    def->label = L("Slice cache size");
+    def->tooltip = L("Maximum size of the slice cache in megabytes. When exceeded, the least recently used entries are removed. "
+                     "Set to zero for no limit.");
+    def->sidetext = L("MB");
+    def->min = 0;
+    def->set_default_value(new ConfigOptionInt(1024));
+
     def = this->add("threads", coInt);
     def->label = L("Maximum number of threads");
     def->tooltip = L("Sets the maximum number of threads the slicing process will use. If not defined, it will be decided automatically.");
@@ -56,6 +56,7 @@
 #include "tcbspan/span.hpp"
 #include "libslic3r/Point.hpp"
 #include "libslic3r/InfillAboveBridges.hpp"
+#include "libslic3r/PointsArena.hpp"
 
 using namespace std::literals;
 
@@ -94,6 +95,27 @@ using namespace std::literals;
 
 namespace Slic3r {
 
+// Report how many allocations of Points were served by the per layer arenas, see PointsArena.hpp.
+static void log_points_allocation_stats([[maybe_unused]] const char *step)
+{
+#ifdef SLIC3R_POINTS_ARENA
+    const PointsAllocationStats stats = points_allocation_stats();
+    BOOST_LOG_TRIVIAL(debug) << step << ": " << stats.arena_allocations << " arena allocations, " << stats.heap_allocations << " heap allocations, "
+        << stats.chunks << " arena chunks allocated, " << stats.chunks_alive << " arena chunks alive";
+#endif // SLIC3R_POINTS_ARENA
+}
+
+#ifdef SLIC3R_POINTS_ARENA
+// Copy the results of a layer into fresh heap allocations. To be called after the PointsArenaScope of the layer was left:
+// The results allocated inside the scope would otherwise pin the arena chunks of all the temporaries of the layer
+// for the lifetime of the layer.
+template<typename... Containers>
+static void copy_out_of_points_arena(Containers&... containers)
+{
+    ((containers = Containers(containers)), ...);
+}
+#endif // SLIC3R_POINTS_ARENA
+
 // Constructor is called from the main thread, therefore all Model / ModelObject / ModelIntance data are valid.
 PrintObject::PrintObject(Print* print, ModelObject* model_object, const Transform3d& trafo, PrintInstances&& instances) :
     PrintObjectBaseWithState(print, model_object),
@@ -169,11 +191,16 @@ void PrintObject::make_perimeters()
 
     m_print->set_status(20, _u8L("Generating perimeters"));
     BOOST_LOG_TRIVIAL(info) << "Generating perimeters..." << log_memory_info();
+
+    // Perimeters of the layers outside of this span are still valid, see invalidate_layer_range_by_config_options().
+    const auto [layers_begin, layers_end] = this->invalid_layers();
     
     // Revert the typed slices into untyped slices.
     if (m_typed_slices) {
-        for (Layer *layer : m_layers) {
-            layer->clear_fills();
+        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
+            Layer *layer = m_layers[layer_idx];
+            if (layer_idx >= layers_begin && layer_idx < layers_end)
+                layer->clear_fills();
             layer->restore_untyped_slices();
             m_print->throw_if_canceled();
         }
@@ -252,18 +279,29 @@ void PrintObject::make_perimeters()
         BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
     }
 
-    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
+    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters of layers " << layers_begin << " to " << layers_end << " in parallel - start";
+    reset_points_allocation_stats();
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
+        tbb::blocked_range<size_t>(layers_begin, layers_end),
         [this](const tbb::blocked_range<size_t>& range) {
             PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
-                m_layers[layer_idx]->make_perimeters();
+                {
+                    PointsArenaScope points_arena;
+                    m_layers[layer_idx]->build_lslices_distancer();
+                    m_layers[layer_idx]->make_perimeters();
+                }
+#ifdef SLIC3R_POINTS_ARENA
+                for (LayerRegion *layerm : m_layers[layer_idx]->regions())
+                    copy_out_of_points_arena(layerm->m_perimeters, layerm->m_thin_fills, layerm->m_fill_expolygons, layerm->m_fill_surfaces,
+                        layerm->fill_no_overlap_expolygons);
+#endif // SLIC3R_POINTS_ARENA
             }
         }
     );
     m_print->throw_if_canceled();
+    log_points_allocation_stats("Generating perimeters");
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
 
     this->set_done(posPerimeters);
@@ -423,8 +461,9 @@ PrepareInfill::separate_infill_above_bridges(surfaces, infill_over_bridges_expan
 
 void PrintObject::clear_fills()
 {
-    for (Layer *layer : m_layers)
-        layer->clear_fills();
+    const auto [layers_begin, layers_end] = this->invalid_layers();
+    for (size_t layer_idx = layers_begin; layer_idx < layers_end; ++ layer_idx)
+        m_layers[layer_idx]->clear_fills();
 }
 
 void PrintObject::infill()
@@ -438,18 +477,28 @@ void PrintObject::infill()
         const auto& adaptive_fill_octree = this->m_adaptive_fill_octrees.first;
         const auto& support_fill_octree = this->m_adaptive_fill_octrees.second;
 
-        BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
+        const auto [layers_begin, layers_end] = this->invalid_layers();
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers " << layers_begin << " to " << layers_end << " in parallel - start";
+        reset_points_allocation_stats();
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size()),
+            tbb::blocked_range<size_t>(layers_begin, layers_end),
             [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree](const tbb::blocked_range<size_t>& range) {
                 PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get(), this->m_lightning_generator.get());
+                    {
+                        PointsArenaScope points_arena;
+                        m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get(), this->m_lightning_generator.get());
+                    }
+#ifdef SLIC3R_POINTS_ARENA
+                    for (LayerRegion *layerm : m_layers[layer_idx]->regions())
+                        copy_out_of_points_arena(layerm->m_fills);
+#endif // SLIC3R_POINTS_ARENA
                 }
             }
         );
         m_print->throw_if_canceled();
+        log_points_allocation_stats("Filling layers");
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
         /*  we could free memory now, but this would make this step not idempotent
         ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
@@ -462,9 +511,11 @@ void PrintObject::ironing()
 {
     if (this->set_started(posIroning)) {
         BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - start";
+        // Ironing is appended to the fills, thus only the layers with freshly generated fills are ironed.
+        const auto [layers_begin, layers_end] = this->invalid_layers();
         tbb::parallel_for(
             // Ironing starting with layer 0 to support ironing all surfaces.
-            tbb::blocked_range<size_t>(0, m_layers.size()),
+            tbb::blocked_range<size_t>(layers_begin, layers_end),
             [this](const tbb::blocked_range<size_t>& range) {
                 PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
@@ -570,15 +621,13 @@ void PrintObject::calculate_overhanging_perimeters()
 
         if (!regions_with_dynamic_speeds.empty()) {
             std::unordered_map<size_t, AABBTreeLines::LinesDistancer<CurledLine>> curled_lines;
-            std::unordered_map<size_t, AABBTreeLines::LinesDistancer<Linef>>      unscaled_polygons_lines;
-            for (const Layer *l : this->layers()) {
-                curled_lines[l->id()]            = AABBTreeLines::LinesDistancer<CurledLine>{l->curled_lines};
-                unscaled_polygons_lines[l->id()] = AABBTreeLines::LinesDistancer<Linef>{to_unscaled_linesf(l->lslices)};
-            }
-            curled_lines[size_t(-1)]            = {};
-            unscaled_polygons_lines[size_t(-1)] = {};
+            for (const Layer *l : this->layers())
+                curled_lines[l->id()] = AABBTreeLines::LinesDistancer<CurledLine>{l->curled_lines};
+            const AABBTreeLines::LinesDistancer<Linef> no_lower_layer;
 
-            tbb::parallel_for(tbb::blocked_range<size_t>(0, m_layers.size()), [this, &curled_lines, &unscaled_polygons_lines,
+            // The overhanging perimeters are split in place, thus only the freshly generated perimeters are processed.
+            const auto [layers_begin, layers_end] = this->invalid_layers();
+            tbb::parallel_for(tbb::blocked_range<size_t>(layers_begin, layers_end), [this, &curled_lines, &no_lower_layer,
                                                                                &regions_with_dynamic_speeds](
                                                                                   const tbb::blocked_range<size_t> &range) {
                 PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
@@ -591,10 +640,9 @@ void PrintObject::calculate_overhanging_perimeters()
                         if (regions_with_dynamic_speeds.find(layer_region->m_region) == regions_with_dynamic_speeds.end()) {
                             continue;
                         }
-                        size_t prev_layer_id = l->lower_layer ? l->lower_layer->id() : size_t(-1);
                         layer_region->m_perimeters =
                             ExtrusionProcessor::calculate_and_split_overhanging_extrusions(&layer_region->m_perimeters,
-                                                                                           unscaled_polygons_lines[prev_layer_id],
+                                                                                           l->lower_layer ? l->lower_layer->lslices_distancer() : no_lower_layer,
                                                                                            curled_lines[l->id()]);
                     }
                 }
@@ -810,6 +858,7 @@ bool PrintObject::invalidate_state_by_config_options(
             || opt_key == "support_tree_top_rate"
             || opt_key == "support_tree_branch_distance"
             || opt_key == "support_tree_tip_diameter"
+            || opt_key == "support_tree_collision_mode"
             || opt_key == "raft_expansion"
             || opt_key == "raft_first_layer_density"
             || opt_key == "raft_first_layer_expansion"
@@ -958,9 +1007,105 @@ bool PrintObject::invalidate_state_by_config_options(
     return invalidated;
 }
 
+// Called by Print::apply() for a PrintRegion, which is referenced by a single layer range only.
+// Perimeters, infill and ironing are generated for each layer independently, thus if the object is not to be resliced,
+// only the layers of the layer range need to be regenerated, extended by the layers depending on them
+// through the top / bottom solid shells, extra perimeters and bridges.
+bool PrintObject::invalidate_layer_range_by_config_options(
+    const PrintRegionConfig &old_config, const PrintRegionConfig &new_config, const std::vector<t_config_option_key> &opt_keys,
+    const t_layer_height_range &layer_range)
+{
+    const bool                      layers_done        = this->per_layer_steps_done();
+    const std::pair<size_t, size_t> invalid_layers_old = m_invalid_layers;
+
+    // Invalidates all layers if any per layer step is invalidated.
+    bool invalidated = this->invalidate_state_by_config_options(old_config, new_config, opt_keys);
+    if (! invalidated || ! this->is_step_done(posSlice) || this->per_layer_steps_done())
+        // Either the object will be resliced, thus all layers will be regenerated, or no layer needs to be regenerated.
+        return invalidated;
+
+    // Layers sliced inside the layer range, see slices_to_regions().
+    size_t layers_begin = std::lower_bound(m_layers.begin(), m_layers.end(), layer_range.first,
+        [](const Layer *layer, double z) { return layer->slice_z < z; }) - m_layers.begin();
+    size_t layers_end   = std::lower_bound(m_layers.begin() + layers_begin, m_layers.end(), layer_range.second,
+        [](const Layer *layer, double z) { return layer->slice_z < z; }) - m_layers.begin();
+    this->invalidate_layers(this->layers_depending_on(layers_begin, layers_end, &old_config, &new_config), layers_done, invalid_layers_old);
+    BOOST_LOG_TRIVIAL(debug) << "Layer range " << layer_range.first << " to " << layer_range.second << " invalidated layers " <<
+        m_invalid_layers.first << " to " << m_invalid_layers.second;
+    return invalidated;
+}
+
+bool PrintObject::per_layer_steps_done() const
+{
+    return this->is_step_done(posPerimeters) && this->is_step_done(posInfill) && this->is_step_done(posIroning) &&
+           this->is_step_done(posCalculateOverhangingPerimeters);
+}
+
+// Extend the span of layers [layers_begin, layers_end) by the layers, whose perimeters and infill depend on them.
+// All layers are returned if the per layer steps of any layer depend on the whole object.
+std::pair<size_t, size_t> PrintObject::layers_depending_on(
+    size_t layers_begin, size_t layers_end, const PrintRegionConfig *old_config, const PrintRegionConfig *new_config) const
+{
+    // Combined infill, lightning and adaptive cubic infill depend on the other layers of the object
+    // beyond the reach of the solid shells, spiral vase merges the layers into a single shell.
+    auto regenerates_whole_object = [](const PrintRegionConfig &config) {
+        return config.infill_every_layers.value > 1 || config.automatic_infill_combination.value ||
+               config.fill_pattern.value == ipLightning || config.fill_pattern.value == ipAdaptiveCubic || config.fill_pattern.value == ipSupportCubic;
+    };
+    // Overhanging perimeters are slowed down based on the curling of the layers below, which accumulates from layer to layer.
+    bool    curling_up_to_top   = m_print->config().avoid_crossing_curled_overhangs.value ||
+        std::any_of(m_print->config().enable_dynamic_fan_speeds.values.begin(), m_print->config().enable_dynamic_fan_speeds.values.end(), [](unsigned char v) { return v != 0; });
+    int     num_shell_layers    = 0;
+    double  shell_min_thickness = 0.;
+    bool    whole_object        = m_print->config().spiral_vase.value;
+    auto    update_by_region_config = [&](const PrintRegionConfig &config) {
+        whole_object        |= regenerates_whole_object(config);
+        curling_up_to_top   |= config.enable_dynamic_overhang_speeds.value;
+        num_shell_layers     = std::max({ num_shell_layers, config.top_solid_layers.value, config.bottom_solid_layers.value });
+        shell_min_thickness  = std::max({ shell_min_thickness, config.top_solid_min_thickness.value, config.bottom_solid_min_thickness.value });
+    };
+    if (old_config)
+        update_by_region_config(*old_config);
+    if (new_config)
+        update_by_region_config(*new_config);
+    for (size_t region_id = 0; region_id < this->num_printing_regions(); ++ region_id)
+        update_by_region_config(this->printing_region(region_id).config());
+    if (whole_object)
+        return { 0, std::numeric_limits<size_t>::max() };
+
+    // Extend by the solid shells and by one more layer for extra perimeters, overhangs and bridges depending on the neighbor layers.
+    {
+        double thickness = 0.;
+        for (int i = 0; layers_begin > 0 && (i <= num_shell_layers || thickness < shell_min_thickness); ++ i)
+            thickness += m_layers[-- layers_begin]->height;
+        thickness = 0.;
+        for (int i = 0; layers_end < m_layers.size() && (i <= num_shell_layers || thickness < shell_min_thickness); ++ i)
+            thickness += m_layers[layers_end ++]->height;
+    }
+    // Up to the top of the object, including the layers added by reslicing.
+    if (curling_up_to_top || layers_end >= m_layers.size())
+        layers_end = std::numeric_limits<size_t>::max();
+    return { layers_begin, layers_end };
+}
+
+// Layers of a previous invalidation, which were not regenerated yet, are regenerated as well.
+void PrintObject::invalidate_layers(const std::pair<size_t, size_t> &layers, bool layers_done, const std::pair<size_t, size_t> &invalid_layers_old)
+{
+    m_invalid_layers = layers_done ? layers :
+        std::make_pair(std::min(layers.first, invalid_layers_old.first), std::max(layers.second, invalid_layers_old.second));
+}
+
 bool PrintObject::invalidate_step(PrintObjectStep step)
 {
 	bool invalidated = Inherited::invalidate_step(step);
+
+    // All layers are to be regenerated by default, see invalidate_layer_range_by_config_options().
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill || step == posInfill || step == posIroning ||
+        step == posCalculateOverhangingPerimeters)
+        m_invalid_layers = { 0, std::numeric_limits<size_t>::max() };
+    // All layers are to be resliced by default, see invalidate_layer_height_profile().
+    if (step == posSlice)
+        m_keep_unchanged_layers = false;
     
     // propagate to dependent steps
     if (step == posPerimeters) {
@@ -976,6 +1121,8 @@ bool PrintObject::invalidate_step(PrintObjectStep step)
                                                posSupportMaterial, posEstimateCurledExtrusions, posCalculateOverhangingPerimeters});
         invalidated |= m_print->invalidate_steps({ psSkirtBrim });
         m_slicing_params.valid = false;
+        // The tree support collisions and avoidances are calculated from the slices.
+        m_tree_model_volumes.reset();
     } else if (step == posSupportMaterial) {
         invalidated |= m_print->invalidate_steps({ psSkirtBrim,  });
         invalidated |= this->invalidate_steps({ posEstimateCurledExtrusions });
@@ -999,6 +1146,9 @@ bool PrintObject::invalidate_all_steps()
     bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
 	// Then reset some of the depending values.
 	m_slicing_params.valid = false;
+    m_invalid_layers       = { 0, std::numeric_limits<size_t>::max() };
+    m_keep_unchanged_layers = false;
+    m_tree_model_volumes.reset();
 	return result;
 }
 
@@ -1076,10 +1226,12 @@ void PrintObject::detect_surfaces_type()
                     // of current layer and upper one)
                     Surfaces top;
                     if (upper_layer) {
-                        ExPolygons upper_slices = interface_shells ? 
-                            diff_ex(layerm->slices().surfaces, upper_layer->m_regions[region_id]->slices().surfaces, ApplySafetyOffset::Yes) :
-                            diff_ex(layerm->slices().surfaces, upper_layer->lslices, ApplySafetyOffset::Yes);
-                        surfaces_append(top, opening_ex(upper_slices, offset), stTop);
+                        ClipperPipeline upper_slices(layerm->slices().surfaces);
+                        if (interface_shells)
+                            upper_slices.diff(upper_layer->m_regions[region_id]->slices().surfaces, ApplySafetyOffset::Yes);
+                        else
+                            upper_slices.diff(upper_layer->lslices, ApplySafetyOffset::Yes);
+                        surfaces_append(top, upper_slices.opening(offset).expolygons(), stTop);
                     } else {
                         // if no upper layer, all surfaces of this one are solid
                         // we clone surfaces because we're going to clear the slices collection
@@ -1103,9 +1255,10 @@ void PrintObject::detect_surfaces_type()
                         // Any surface lying on the void is a true bottom bridge (an overhang)
                         surfaces_append(
                             bottom,
-                            opening_ex(
-                                diff_ex(layerm->slices().surfaces, lower_layer->lslices, ApplySafetyOffset::Yes),
-                                offset),
+                            ClipperPipeline(layerm->slices().surfaces)
+                                .diff(lower_layer->lslices, ApplySafetyOffset::Yes)
+                                .opening(offset)
+                                .expolygons(),
                             surface_type_bottom_other);
                         // if user requested internal shells, we need to identify surfaces
                         // lying on other slices not belonging to this region
@@ -1114,12 +1267,11 @@ void PrintObject::detect_surfaces_type()
                             // on something else, excluding those lying on our own region
                             surfaces_append(
                                 bottom,
-                                opening_ex(
-                                    diff_ex(
-                                        intersection(layerm->slices().surfaces, lower_layer->lslices), // supported
-                                        lower_layer->m_regions[region_id]->slices().surfaces,
-                                        ApplySafetyOffset::Yes),
-                                    offset),
+                                ClipperPipeline(layerm->slices().surfaces)
+                                    .intersection(lower_layer->lslices) // supported
+                                    .diff(lower_layer->m_regions[region_id]->slices().surfaces, ApplySafetyOffset::Yes)
+                                    .opening(offset)
+                                    .expolygons(),
                                 stBottom);
                         }
 #endif
@@ -1678,13 +1830,15 @@ void PrintObject::discover_vertical_shells()
                         const float narrow_sparse_infill_region_radius                  = 0.5f * 1.2f * min_perimeter_infill_spacing;
                         // Finally expand the infill a bit to remove tiny gaps between solid infill and the other regions.
                         const float tiny_overlap_radius                                 = 0.2f        * min_perimeter_infill_spacing;
-                        regularized_shell = shrink_ex(offset2_ex(union_ex(shell),
+                        regularized_shell = ClipperPipeline(shell)
+                            .union_()
                             // Open to remove (filter out) regions narrower than an infill extrusion line width.
-                            -narrow_ensure_vertical_wall_thickness_region_radius,
+                            .shrink(narrow_ensure_vertical_wall_thickness_region_radius, ClipperLib::jtSquare)
                             // Then close gaps narrower than 1.2 * line width, such gaps are difficult to fill in with sparse infill.
-                            narrow_ensure_vertical_wall_thickness_region_radius + narrow_sparse_infill_region_radius, ClipperLib::jtSquare),
+                            .expand(narrow_ensure_vertical_wall_thickness_region_radius + narrow_sparse_infill_region_radius, ClipperLib::jtSquare)
                             // Finally expand the infill a bit to remove tiny gaps between solid infill and the other regions.
-                            narrow_sparse_infill_region_radius - tiny_overlap_radius, ClipperLib::jtSquare);
+                            .shrink(narrow_sparse_infill_region_radius - tiny_overlap_radius, ClipperLib::jtSquare)
+                            .expolygons();
 
                         Polygons object_volume;
                         Polygons internal_volume;
@@ -1837,14 +1991,18 @@ void PrintObject::bridge_over_infill()
                         }
                     }
                 }
-                unsupported_area = closing(unsupported_area, float(SCALED_EPSILON));
                 // By expanding the lower layer solids, we avoid making bridges from the tiny internal overhangs that are (very likely) supported by previous layer solids
                 // NOTE that we cannot filter out polygons worth bridging by their area, because sometimes there is a very small internal island that will grow into large hole
-                lower_layer_solids = shrink(lower_layer_solids, 1 * spacing); // first remove thin regions that will not support anything
-                lower_layer_solids = expand(lower_layer_solids, (1 + 3) * spacing); // then expand back (opening), and further for parts supported by internal solids
-                // By shrinking the unsupported area, we avoid making bridges from narrow ensuring region along perimeters.
-                unsupported_area   = shrink(unsupported_area, 3 * spacing);
-                unsupported_area   = diff(unsupported_area, lower_layer_solids);
+                lower_layer_solids = ClipperPipeline(std::move(lower_layer_solids))
+                    .shrink(1 * spacing)        // first remove thin regions that will not support anything
+                    .expand((1 + 3) * spacing)  // then expand back (opening), and further for parts supported by internal solids
+                    .polygons();
+                unsupported_area   = ClipperPipeline(std::move(unsupported_area))
+                    .closing(float(SCALED_EPSILON))
+                    // By shrinking the unsupported area, we avoid making bridges from narrow ensuring region along perimeters.
+                    .shrink(3 * spacing)
+                    .diff(lower_layer_solids)
+                    .polygons();
 
                 for (const LayerRegion *region : layer->regions()) {
                     SurfacesPtr region_internal_solids = region->fill_surfaces().filter_by_type(stInternalSolid);
@@ -2514,11 +2672,13 @@ void PrintObject::bridge_over_infill()
                         }
                     }
 
-                    bridging_area          = opening(bridging_area, flow.scaled_spacing());
-                    bridging_area          = closing(bridging_area, flow.scaled_spacing());
-                    bridging_area          = intersection(bridging_area, limiting_area);
-                    bridging_area          = intersection(bridging_area, total_fill_area);
-                    bridging_area          = diff(bridging_area, total_top_area);
+                    bridging_area          = ClipperPipeline(std::move(bridging_area))
+                                                 .opening(flow.scaled_spacing())
+                                                 .closing(flow.scaled_spacing())
+                                                 .intersection(limiting_area)
+                                                 .intersection(total_fill_area)
+                                                 .diff(total_top_area)
+                                                 .polygons();
                     expansion_area         = diff(expansion_area, bridging_area);
 
 #ifdef DEBUG_BRIDGE_OVER_INFILL
@@ -3210,6 +3370,8 @@ void PrintObject::_generate_support_material()
     if (this->has_support() && (m_config.support_material_style == smsTree || m_config.support_material_style == smsOrganic)) {
         fff_tree_support_generate(*this, std::function<void()>([this](){ this->throw_if_canceled(); }));
     } else {
+        // Tree supports are not generated, release their collision and avoidance areas.
+        m_tree_model_volumes.reset();
         // If support style is set to Organic however only raft will be built but no support,
         // build snug raft instead.
         PrintObjectSupportMaterial support_material(this, m_slicing_params);
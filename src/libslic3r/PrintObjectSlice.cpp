@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +32,7 @@
 #include "libslic3r/Polygon.hpp"
 #include "libslic3r/PrintBase.hpp"
 #include "libslic3r/PrintConfig.hpp"
+#include "libslic3r/SliceCache.hpp"
 #include "libslic3r/Slicing.hpp"
 #include "libslic3r/Surface.hpp"
 #include "libslic3r/TriangleMesh.hpp"
@@ -65,24 +68,114 @@ LayerPtrs new_layers(
     return out;
 }
 
+static bool mesh_slicing_params_equal(const MeshSlicingParamsEx &lhs, const MeshSlicingParamsEx &rhs)
+{
+    return lhs.mode == rhs.mode && lhs.slicing_mode_normal_below_layer == rhs.slicing_mode_normal_below_layer && lhs.mode_below == rhs.mode_below &&
+           lhs.trafo.matrix() == rhs.trafo.matrix() && lhs.closing_radius == rhs.closing_radius && lhs.extra_offset == rhs.extra_offset &&
+           lhs.resolution == rhs.resolution;
+}
+
+static size_t expolygons_memsize(const std::vector<ExPolygons> &layers)
+{
+    size_t out = layers.capacity() * sizeof(ExPolygons);
+    for (const ExPolygons &expolygons : layers) {
+        out += expolygons.capacity() * sizeof(ExPolygon);
+        for (const ExPolygon &expolygon : expolygons) {
+            out += expolygon.contour.points.capacity() * sizeof(Point) + expolygon.holes.capacity() * sizeof(Polygon);
+            for (const Polygon &hole : expolygon.holes)
+                out += hole.points.capacity() * sizeof(Point);
+        }
+    }
+    return out;
+}
+
+// Store the slices of a volume into the cache, replacing the previous slices of the same volume.
+// Then drop the least recently used entries until the cache fits into its memory limit.
+static void volume_slices_cache_store(PrintObjectRegions::VolumeSlicesCache &cache, const ModelVolume &volume, const MeshSlicingParamsEx &params,
+    const std::vector<float> &zs, const std::vector<ExPolygons> &layers)
+{
+    auto &entries = cache.volumes;
+    auto  it      = std::find_if(entries.begin(), entries.end(), [&volume](const PrintObjectRegions::VolumeSlices &vs) { return vs.volume_id == volume.id(); });
+    PrintObjectRegions::VolumeSlices &vs = it == entries.end() ? entries.emplace_back() : *it;
+    vs.volume_id = volume.id();
+    vs.mesh      = volume.get_mesh_shared_ptr();
+    vs.params    = params;
+    vs.zs        = zs;
+    vs.slices    = layers;
+    vs.memsize   = expolygons_memsize(vs.slices);
+    vs.last_used = ++ cache.timestamp;
+
+    size_t memsize = 0;
+    for (const PrintObjectRegions::VolumeSlices &entry : entries)
+        memsize += entry.memsize;
+    while (memsize > cache.max_memsize) {
+        auto it_lru = std::min_element(entries.begin(), entries.end(),
+            [](const PrintObjectRegions::VolumeSlices &l, const PrintObjectRegions::VolumeSlices &r) { return l.last_used < r.last_used; });
+        memsize -= it_lru->memsize;
+        entries.erase(it_lru);
+    }
+}
+
 // Slice single triangle mesh.
+// If cache is provided, the slices found in the cache at the same slicing planes are reused and only the remaining planes are sliced.
+// The cache is then updated with the slices produced by this call.
 static std::vector<ExPolygons> slice_volume(
-    const ModelVolume             &volume,
-    const std::vector<float>      &zs, 
-    const MeshSlicingParamsEx     &params,
-    const std::function<void()>   &throw_on_cancel_callback)
+    const ModelVolume                       &volume,
+    const std::vector<float>                &zs, 
+    const MeshSlicingParamsEx               &params,
+    PrintObjectRegions::VolumeSlicesCache   *cache,
+    const std::function<void()>             &throw_on_cancel_callback)
 {
     std::vector<ExPolygons> layers;
-    if (! zs.empty()) {
-        indexed_triangle_set its = volume.mesh().its;
-        if (its.indices.size() > 0) {
-            MeshSlicingParamsEx params2 { params };
-            params2.trafo = params2.trafo * volume.get_matrix();
+    if (! zs.empty() && ! volume.mesh().empty()) {
+        MeshSlicingParamsEx params2 { params };
+        params2.trafo = params2.trafo * volume.get_matrix();
+        // In vase mode the layers are sliced differently depending on their index, thus they could not be reused.
+        if (params2.slicing_mode_normal_below_layer != 0)
+            cache = nullptr;
+
+        // Indices of zs to be sliced.
+        std::vector<size_t> missing;
+        if (cache != nullptr) {
+            layers.assign(zs.size(), ExPolygons());
+            std::scoped_lock lock(cache->mutex);
+            if (auto it = std::find_if(cache->volumes.begin(), cache->volumes.end(), [&volume](const PrintObjectRegions::VolumeSlices &vs) { return vs.volume_id == volume.id(); });
+                it != cache->volumes.end() && it->mesh == volume.get_mesh_shared_ptr() && mesh_slicing_params_equal(it->params, params2)) {
+                for (size_t i = 0; i < zs.size(); ++ i)
+                    if (auto it_z = std::lower_bound(it->zs.begin(), it->zs.end(), zs[i]); it_z != it->zs.end() && *it_z == zs[i])
+                        layers[i] = it->slices[it_z - it->zs.begin()];
+                    else
+                        missing.emplace_back(i);
+                it->last_used = ++ cache->timestamp;
+                BOOST_LOG_TRIVIAL(debug) << "Slicing volume " << volume.id().id << ": reusing " << zs.size() - missing.size() << " of " << zs.size() << " layers";
+            } else {
+                missing.assign(zs.size(), 0);
+                std::iota(missing.begin(), missing.end(), 0);
+            }
+        }
+
+        if (cache == nullptr || ! missing.empty()) {
+            indexed_triangle_set its = volume.mesh().its;
             if (params2.trafo.rotation().determinant() < 0.)
                 its_flip_triangles(its);
-            layers = slice_mesh_ex(its, zs, params2, throw_on_cancel_callback);
+            if (cache == nullptr || missing.size() == zs.size()) {
+                layers = slice_mesh_ex_cached(its, zs, params2, throw_on_cancel_callback);
+            } else {
+                std::vector<float> zs_missing;
+                zs_missing.reserve(missing.size());
+                for (size_t i : missing)
+                    zs_missing.emplace_back(zs[i]);
+                std::vector<ExPolygons> sliced = slice_mesh_ex_cached(its, zs_missing, params2, throw_on_cancel_callback);
+                for (size_t i = 0; i < missing.size(); ++ i)
+                    layers[missing[i]] = std::move(sliced[i]);
+            }
             throw_on_cancel_callback();
         }
+
+        if (cache != nullptr && ! missing.empty()) {
+            std::scoped_lock lock(cache->mutex);
+            volume_slices_cache_store(*cache, volume, params2, zs, layers);
+        }
     }
     return layers;
 }
@@ -94,13 +187,14 @@ static std::vector<ExPolygons> slice_volume(
     const std::vector<float>                    &z,
     const std::vector<t_layer_height_range>     &ranges,
     const MeshSlicingParamsEx                   &params,
+    PrintObjectRegions::VolumeSlicesCache       *cache,
     const std::function<void()>                 &throw_on_cancel_callback)
 {
     std::vector<ExPolygons> out;
     if (! z.empty() && ! ranges.empty()) {
         if (ranges.size() == 1 && z.front() >= ranges.front().first && z.back() < ranges.front().second) {
             // All layers fit into a single range.
-            out = slice_volume(volume, z, params, throw_on_cancel_callback);
+            out = slice_volume(volume, z, params, cache, throw_on_cancel_callback);
         } else {
             std::vector<float>                     z_filtered;
             std::vector<std::pair<size_t, size_t>> n_filtered;
@@ -116,7 +210,7 @@ static std::vector<ExPolygons> slice_volume(
                     n_filtered.emplace_back(std::make_pair(first, i));
             }
             if (! n_filtered.empty()) {
-                std::vector<ExPolygons> layers = slice_volume(volume, z_filtered, params, throw_on_cancel_callback);
+                std::vector<ExPolygons> layers = slice_volume(volume, z_filtered, params, cache, throw_on_cancel_callback);
                 out.assign(z.size(), ExPolygons());
                 i = 0;
                 for (const std::pair<size_t, size_t> &span : n_filtered)
@@ -151,6 +245,7 @@ static std::vector<VolumeSlices> slice_volumes_inner(
     ModelVolumePtrs                                           model_volumes,
     const std::vector<PrintObjectRegions::LayerRangeRegions> &layer_ranges,
     const std::vector<float>                                 &zs,
+    PrintObjectRegions::VolumeSlicesCache                    *cache,
     const std::function<void()>                              &throw_on_cancel_callback)
 {
     model_volumes_sort_by_id(model_volumes);
@@ -202,7 +297,7 @@ static std::vector<VolumeSlices> slice_volumes_inner(
                     }
                     out.push_back({
                         model_volume->id(), 
-                        slice_volume(*model_volume, zs, params, throw_on_cancel_callback)
+                        slice_volume(*model_volume, zs, params, cache, throw_on_cancel_callback)
                     });
                 }
             } else {
@@ -214,7 +309,7 @@ static std::vector<VolumeSlices> slice_volumes_inner(
                 if (! slicing_ranges.empty())
                     out.push_back({ 
                         model_volume->id(), 
-                        slice_volume(*model_volume, zs, slicing_ranges, params, throw_on_cancel_callback)
+                        slice_volume(*model_volume, zs, slicing_ranges, params, cache, throw_on_cancel_callback)
                     });
             }
             if (! out.empty() && out.back().slices.empty())
@@ -514,6 +609,58 @@ std::string fix_slicing_errors(LayerPtrs &layers, const std::function<void()> &t
 }
 */
 
+// Number of layers at the bottom and at the top of layers, which keep their Z when generated from object_layers
+// (pairs of bottom/top Z coordinate, without the raft). The top layers are only matched if the number of layers did not change.
+static std::pair<size_t, size_t> num_unchanged_layers(const LayerPtrs &layers, const std::vector<coordf_t> &object_layers, coordf_t zmin)
+{
+    const size_t num_layers = object_layers.size() / 2;
+    auto unchanged = [&layers, &object_layers, zmin](size_t i) {
+        coordf_t lo = object_layers[2 * i];
+        coordf_t hi = object_layers[2 * i + 1];
+        return layers[i]->print_z == hi + zmin && layers[i]->height == hi - lo;
+    };
+    size_t num_bottom = 0;
+    for (; num_bottom < std::min(layers.size(), num_layers) && unchanged(num_bottom); ++ num_bottom) ;
+    size_t num_top = 0;
+    if (layers.size() == num_layers)
+        for (; num_bottom + num_top < num_layers && unchanged(num_layers - num_top - 1); ++ num_top) ;
+    return { num_bottom, num_top };
+}
+
+// Called by Print::apply() if the layer height profile is the only modification of the ModelObject.
+// Layers, which keep their Z, are kept by the next slice() together with their perimeters and infill. Only the layers of the edited
+// band are sliced again, and only those and the layers depending on them through the solid shells are regenerated by the per layer steps.
+bool PrintObject::invalidate_layer_height_profile()
+{
+    const bool                      layers_done        = this->per_layer_steps_done();
+    const std::pair<size_t, size_t> invalid_layers_old = m_invalid_layers;
+    const bool                      sliced             = this->is_step_done(posSlice);
+    // Stop the background processing first if it is slicing this object. The layers were not touched by slice() since they were kept
+    // by the previous edit of the layer height profile, if m_keep_unchanged_layers is still set.
+    bool        invalidated  = Inherited::invalidate_step(posSlice);
+    const bool  keep_layers  = (sliced || m_keep_unchanged_layers) && ! m_layers.empty();
+    invalidated |= this->invalidate_step(posSlice);
+
+    // Painted segmentation and interlocking are calculated over the whole object, spiral vase slices layers depending on their index.
+    if (! keep_layers || m_print->config().spiral_vase.value || m_config.interlocking_beam ||
+        (m_print->config().nozzle_diameter.size() > 1 && this->model_object()->is_mm_painted()) || this->model_object()->is_fuzzy_skin_painted())
+        return invalidated;
+
+    this->update_slicing_parameters();
+    std::vector<coordf_t> layer_height_profile;
+    this->update_layer_height_profile(*this->model_object(), m_slicing_params, layer_height_profile);
+    auto [num_bottom, num_top] = num_unchanged_layers(m_layers,
+        generate_object_layers(m_slicing_params, layer_height_profile, m_config.precise_z_height.value), m_slicing_params.object_print_z_min);
+    if (num_bottom == 0 && num_top == 0)
+        return invalidated;
+
+    m_keep_unchanged_layers = true;
+    this->invalidate_layers(this->layers_depending_on(num_bottom, m_layers.size() - num_top), layers_done, invalid_layers_old);
+    BOOST_LOG_TRIVIAL(debug) << "Layer height profile edited, keeping " << num_bottom << " bottom and " << num_top << " top layers, invalidated layers " <<
+        m_invalid_layers.first << " to " << m_invalid_layers.second;
+    return invalidated;
+}
+
 // Called by make_perimeters()
 // 1) Decides Z positions of the layers,
 // 2) Initializes layers and their regions
@@ -530,12 +677,38 @@ void PrintObject::slice()
     std::vector<coordf_t> layer_height_profile;
     this->update_layer_height_profile(*this->model_object(), m_slicing_params, layer_height_profile);
     m_print->throw_if_canceled();
-    m_typed_slices = false;
-    this->clear_layers();
     //w27
-    m_layers = new_layers(this, generate_object_layers(m_slicing_params, layer_height_profile, m_config.precise_z_height.value));
-    this->slice_volumes();
+    std::vector<coordf_t> object_layers = generate_object_layers(m_slicing_params, layer_height_profile, m_config.precise_z_height.value);
+    // Layers below and above the edited band of the layer height profile are kept with their slices, perimeters and infill,
+    // see invalidate_layer_height_profile().
+    auto [num_bottom, num_top] = m_keep_unchanged_layers ?
+        num_unchanged_layers(m_layers, object_layers, m_slicing_params.object_print_z_min) : std::make_pair(size_t(0), size_t(0));
+    m_keep_unchanged_layers = false;
+    if (num_bottom == 0 && num_top == 0) {
+        m_typed_slices = false;
+        this->clear_layers();
+        m_layers = new_layers(this, object_layers);
+    } else {
+        LayerPtrs layers = new_layers(this, object_layers);
+        for (size_t i = 0; i < layers.size(); ++ i)
+            if (i < num_bottom || i + num_top >= layers.size()) {
+                delete layers[i];
+                layers[i] = m_layers[i];
+                m_layers[i] = nullptr;
+            }
+        this->clear_layers();
+        for (size_t i = 0; i < layers.size(); ++ i) {
+            layers[i]->lower_layer = i == 0 ? nullptr : layers[i - 1];
+            layers[i]->upper_layer = i + 1 == layers.size() ? nullptr : layers[i + 1];
+        }
+        m_layers = std::move(layers);
+        BOOST_LOG_TRIVIAL(debug) << "Slicing objects - keeping " << num_bottom << " bottom and " << num_top << " top layers of " << m_layers.size();
+    }
+    this->slice_volumes(num_bottom, m_layers.size() - num_top);
     m_print->throw_if_canceled();
+    // Layers sliced by slice_volumes(), the top empty layers may have been removed.
+    const size_t layers_begin = num_bottom;
+    const size_t layers_end   = m_layers.size() - num_top;
 #if 0
     // Layer::slicing_errors is no more set since 1.41.1 or possibly earlier, thus this code
     // was not really functional for a long day and nobody missed it.
@@ -550,7 +723,7 @@ void PrintObject::slice()
 #endif
     // Update bounding boxes, back up raw slices of complex models.
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
+        tbb::blocked_range<size_t>(layers_begin, layers_end),
         [this](const tbb::blocked_range<size_t> &range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
@@ -563,8 +736,15 @@ void PrintObject::slice()
             }
         });
     // Interlink the lslices into a Z graph.
+    // Links of the kept layers to the layers sliced again are dropped first.
+    if (layers_begin > 0)
+        for (LayerSlice &lslice : m_layers[layers_begin - 1]->lslices_ex)
+            lslice.overlaps_above.clear();
+    if (layers_end < m_layers.size())
+        for (LayerSlice &lslice : m_layers[layers_end]->lslices_ex)
+            lslice.overlaps_below.clear();
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(1, m_layers.size()),
+        tbb::blocked_range<size_t>(std::max<size_t>(layers_begin, 1), std::min(layers_end + 1, m_layers.size())),
         [this](const tbb::blocked_range<size_t> &range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
@@ -851,41 +1031,48 @@ void apply_fuzzy_skin_segmentation(PrintObject &print_object, ThrowOnCancel thro
 // Resulting expolygons of layer regions are marked as Internal.
 //
 // this should be idempotent
-void PrintObject::slice_volumes()
+// Slice the layers [layers_begin, layers_end), the other layers were kept from the previous slicing by slice().
+void PrintObject::slice_volumes(size_t layers_begin, size_t layers_end)
 {
-    BOOST_LOG_TRIVIAL(info) << "Slicing volumes..." << log_memory_info();
+    BOOST_LOG_TRIVIAL(info) << "Slicing volumes of layers " << layers_begin << " to " << layers_end << "..." << log_memory_info();
     const Print *print                      = this->print();
     const auto   throw_on_cancel_callback   = std::function<void()>([print](){ print->throw_if_canceled(); });
+    assert(layers_begin <= layers_end && layers_end <= m_layers.size());
+    // Painted segmentation and interlocking work over the whole object, see PrintObject::invalidate_layer_height_profile().
+    assert((layers_begin == 0 && layers_end == m_layers.size()) ||
+           (! (print->config().nozzle_diameter.size() > 1 && this->model_object()->is_mm_painted()) && ! this->model_object()->is_fuzzy_skin_painted() && ! m_config.interlocking_beam));
 
     // Clear old LayerRegions, allocate for new PrintRegions.
-    for (Layer* layer : m_layers) {
+    for (size_t layer_id = layers_begin; layer_id < layers_end; ++ layer_id) {
+        Layer *layer = m_layers[layer_id];
         layer->m_regions.clear();
         layer->m_regions.reserve(m_shared_regions->all_regions.size());
         for (const std::unique_ptr<PrintRegion> &pr : m_shared_regions->all_regions)
             layer->m_regions.emplace_back(new LayerRegion(layer, pr.get()));
     }
 
-    std::vector<float>                   slice_zs      = zs_from_layers(m_layers);
+    std::vector<float>                   slice_zs      = zs_from_layers(tcb::span<Layer* const>(m_layers.data() + layers_begin, layers_end - layers_begin));
     std::vector<std::vector<ExPolygons>> region_slices = slices_to_regions(this->model_object()->volumes, *m_shared_regions, slice_zs,
         slice_volumes_inner(
             print->config(), this->config(), this->trafo_centered(),
-            this->model_object()->volumes, m_shared_regions->layer_ranges, slice_zs, throw_on_cancel_callback),
+            this->model_object()->volumes, m_shared_regions->layer_ranges, slice_zs, &m_shared_regions->cached_volume_slices, throw_on_cancel_callback),
         throw_on_cancel_callback);
 
     for (size_t region_id = 0; region_id < region_slices.size(); ++ region_id) {
         std::vector<ExPolygons> &by_layer = region_slices[region_id];
         for (size_t layer_id = 0; layer_id < by_layer.size(); ++ layer_id)
-            m_layers[layer_id]->regions()[region_id]->m_slices.append(std::move(by_layer[layer_id]), stInternal);
+            m_layers[layers_begin + layer_id]->regions()[region_id]->m_slices.append(std::move(by_layer[layer_id]), stInternal);
     }
     region_slices.clear();
     
     BOOST_LOG_TRIVIAL(debug) << "Slicing volumes - removing top empty layers";
-    while (! m_layers.empty()) {
+    while (m_layers.size() > layers_begin && layers_end == m_layers.size()) {
         const Layer *layer = m_layers.back();
         if (! layer->empty())
             break;
         delete layer;
         m_layers.pop_back();
+        -- layers_end;
     }
     if (! m_layers.empty())
         m_layers.back()->upper_layer = nullptr;
@@ -949,7 +1136,7 @@ void PrintObject::slice_volumes()
         //w26
         lslices_elfoot_uncompensated.resize(elephant_foot_compensation_scaled > 0 ? std::min(m_config.elefant_foot_compensation_layers.value, (int)m_layers.size()) : 0);
 	    tbb::parallel_for(
-	        tbb::blocked_range<size_t>(0, m_layers.size()),
+	        tbb::blocked_range<size_t>(layers_begin, layers_end),
             //w12
             //w24
             [this, xy_hole_scaled, xy_contour_scaled, elephant_foot_compensation_scaled, &lslices_elfoot_uncompensated](const tbb::blocked_range<size_t>& range) {
@@ -1060,7 +1247,7 @@ void PrintObject::slice_volumes()
 			//layer.lslices = std::move(lslices_1st_layer);
             //layer.lslice_indices_sorted_by_print_order = chain_expolygons(layer.lslices);
             //w24
-            for (int i = 0; i < lslices_elfoot_uncompensated.size(); i++) {
+            for (int i = int(layers_begin); i < int(std::min(lslices_elfoot_uncompensated.size(), layers_end)); i++) {
                 ExPolygons &expolygons_uncompensated = lslices_elfoot_uncompensated[i];
                 Points ordering_points;
                 ordering_points.reserve(expolygons_uncompensated.size());
@@ -1127,7 +1314,7 @@ std::vector<Polygons> PrintObject::slice_support_volumes(const ModelVolumeType m
         params.trafo = this->trafo_centered();
         for (; it_volume != it_volume_end; ++ it_volume)
             if ((*it_volume)->type() == model_volume_type) {
-                std::vector<ExPolygons> slices2 = slice_volume(*(*it_volume), zs, params, throw_on_cancel_callback);
+                std::vector<ExPolygons> slices2 = slice_volume(*(*it_volume), zs, params, nullptr, throw_on_cancel_callback);
                 if (slices.empty()) {
                     slices.reserve(slices2.size());
                     for (ExPolygons &src : slices2)
@@ -19,7 +19,7 @@ class Line;
 	namespace ClipperLib {
 		class PolyNode;
 
-		using PolyNodes = std::vector<PolyNode*, PointsAllocator<PolyNode*>>;
+		using PolyNodes = std::vector<PolyNode*, tbb::scalable_allocator<PolyNode*>>;
 	}
 
 class ExPolygon;
@@ -0,0 +1,366 @@
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <type_traits>
+
+#include "SliceCache.hpp"
+#include "Utils.hpp"
+#include "admesh/stl.h"
+
+namespace Slic3r {
+
+static std::string g_slice_cache_dir;
+static size_t      g_slice_cache_max_size = size_t(1024) << 20;
+
+void set_slice_cache_dir(const std::string &path)
+{
+    g_slice_cache_dir.clear();
+    if (path.empty())
+        return;
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path, ec);
+    if (ec || ! boost::filesystem::is_directory(path, ec))
+        BOOST_LOG_TRIVIAL(error) << "Slice cache directory " << path << " is not accessible, slice cache disabled.";
+    else
+        g_slice_cache_dir = path;
+}
+
+const std::string& slice_cache_dir()
+{
+    return g_slice_cache_dir;
+}
+
+void set_slice_cache_max_size(size_t size)
+{
+    g_slice_cache_max_size = size;
+}
+
+size_t slice_cache_max_size()
+{
+    return g_slice_cache_max_size;
+}
+
+namespace {
+
+// Fast non-cryptographic hash processing the input in 64bit words with the splitmix64 finalizer.
+class SliceCacheHasher
+{
+public:
+    explicit SliceCacheHasher(uint64_t seed) : m_hash(mix(seed)) {}
+
+    void add_bytes(const void *data, size_t size) {
+        auto *p = static_cast<const unsigned char*>(data);
+        for (; size >= 8; p += 8, size -= 8) {
+            uint64_t w;
+            memcpy(&w, p, 8);
+            this->add_word(w);
+        }
+        if (size > 0) {
+            uint64_t w = 0;
+            memcpy(&w, p, size);
+            this->add_word(w ^ (uint64_t(size) << 56));
+        }
+    }
+
+    template<typename T>
+    void add(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->add_bytes(&value, sizeof(T));
+    }
+
+    // Eigen fixed size vectors are not std::is_trivially_copyable, but they are plain arrays of scalars.
+    template<typename T>
+    void add(const std::vector<T> &values) {
+        this->add<uint64_t>(values.size());
+        this->add_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    uint64_t result() const { return mix(m_hash); }
+
+private:
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+    void add_word(uint64_t w) { m_hash = (m_hash ^ mix(w)) * 0x100000001b3ull + 0x9e3779b97f4a7c15ull; }
+
+    uint64_t m_hash;
+};
+
+// Increase if the format of the cache file or the slicing algorithm changes.
+static constexpr const uint32_t SLICE_CACHE_MAGIC   = 0x434c5351; // "QSLC"
+static constexpr const uint32_t SLICE_CACHE_VERSION = 1;
+
+struct SliceCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t coord_size;
+    uint32_t reserved;
+    uint64_t hash_mesh;
+    uint64_t hash_params;
+    uint64_t num_layers;
+};
+
+class SliceCacheWriter
+{
+public:
+    template<typename T> void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const char *p = reinterpret_cast<const char*>(&value);
+        m_data.insert(m_data.end(), p, p + sizeof(T));
+    }
+    void write(const Polygon &polygon) {
+        this->write<uint32_t>(uint32_t(polygon.points.size()));
+        for (const Point &pt : polygon.points) {
+            this->write<coord_t>(pt.x());
+            this->write<coord_t>(pt.y());
+        }
+    }
+    const std::string& data() const { return m_data; }
+private:
+    std::string m_data;
+};
+
+class SliceCacheReader
+{
+public:
+    SliceCacheReader(const char *begin, const char *end) : m_ptr(begin), m_end(end) {}
+    template<typename T> bool read(T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (size_t(m_end - m_ptr) < sizeof(T))
+            return false;
+        memcpy(&value, m_ptr, sizeof(T));
+        m_ptr += sizeof(T);
+        return true;
+    }
+    bool read(Polygon &polygon) {
+        uint32_t n;
+        if (! this->read(n) || size_t(m_end - m_ptr) / (2 * sizeof(coord_t)) < n)
+            return false;
+        polygon.points.assign(n, Point());
+        for (Point &pt : polygon.points) {
+            this->read(pt.x());
+            this->read(pt.y());
+        }
+        return true;
+    }
+    bool at_end() const { return m_ptr == m_end; }
+private:
+    const char *m_ptr;
+    const char *m_end;
+};
+
+std::string slice_cache_file_path(const SliceCacheKey &key)
+{
+    return (boost::filesystem::path(g_slice_cache_dir) / (key.to_string() + ".slices")).string();
+}
+
+// Remove the least recently used entries until the cache fits into g_slice_cache_max_size. The entry just stored is kept.
+// The cache may be shared by multiple processes, thus entries may disappear while being enumerated.
+void slice_cache_evict(const boost::filesystem::path &keep)
+{
+    if (g_slice_cache_max_size == 0)
+        return;
+
+    struct Entry {
+        boost::filesystem::path path;
+        std::time_t             last_used;
+        uintmax_t               size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t          total_size = 0;
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator it(g_slice_cache_dir, ec), end; ! ec && it != end; it.increment(ec)) {
+        const boost::filesystem::path &path = it->path();
+        if (path.extension() != ".slices")
+            continue;
+        boost::system::error_code ec_entry;
+        Entry entry { path, boost::filesystem::last_write_time(path, ec_entry), 0 };
+        if (! ec_entry)
+            entry.size = boost::filesystem::file_size(path, ec_entry);
+        if (! ec_entry) {
+            total_size += entry.size;
+            entries.emplace_back(std::move(entry));
+        }
+    }
+    if (total_size <= g_slice_cache_max_size)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &l, const Entry &r) { return l.last_used < r.last_used; });
+    size_t num_removed = 0;
+    for (const Entry &entry : entries) {
+        if (total_size <= g_slice_cache_max_size)
+            break;
+        if (entry.path == keep)
+            continue;
+        boost::system::error_code ec_remove;
+        boost::filesystem::remove(entry.path, ec_remove);
+        if (! ec_remove) {
+            total_size -= entry.size;
+            ++ num_removed;
+        }
+    }
+    BOOST_LOG_TRIVIAL(debug) << "Slice cache: Removed " << num_removed << " least recently used entries";
+}
+
+} // namespace
+
+std::string SliceCacheKey::to_string() const
+{
+    char buf[33];
+    snprintf(buf, sizeof(buf), "%016" PRIx64 "%016" PRIx64, this->hash_mesh, this->hash_params);
+    return buf;
+}
+
+SliceCacheKey slice_cache_key(const indexed_triangle_set &mesh, const std::vector<float> &zs, const MeshSlicingParamsEx &params)
+{
+    SliceCacheKey key;
+
+    SliceCacheHasher hash_mesh(0x51534c43u);
+    hash_mesh.add(mesh.vertices);
+    hash_mesh.add(mesh.indices);
+    key.hash_mesh = hash_mesh.result();
+
+    SliceCacheHasher hash_params(SLICE_CACHE_VERSION);
+    hash_params.add(zs);
+    hash_params.add(params.mode);
+    hash_params.add<uint64_t>(params.slicing_mode_normal_below_layer);
+    hash_params.add(params.mode_below);
+    hash_params.add_bytes(params.trafo.matrix().data(), 16 * sizeof(double));
+    hash_params.add(params.closing_radius);
+    hash_params.add(params.extra_offset);
+    hash_params.add(params.resolution);
+    key.hash_params = hash_params.result();
+
+    return key;
+}
+
+bool slice_cache_load(const SliceCacheKey &key, const std::vector<float> &zs, std::vector<ExPolygons> &out)
+{
+    if (! slice_cache_enabled())
+        return false;
+
+    std::string data;
+    {
+        boost::nowide::ifstream ifs(slice_cache_file_path(key), std::ios::binary);
+        if (! ifs)
+            return false;
+        data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        if (ifs.bad())
+            return false;
+    }
+
+    SliceCacheReader reader(data.data(), data.data() + data.size());
+    SliceCacheHeader header;
+    if (! reader.read(header) || header.magic != SLICE_CACHE_MAGIC || header.version != SLICE_CACHE_VERSION ||
+        header.coord_size != sizeof(coord_t) || header.hash_mesh != key.hash_mesh || header.hash_params != key.hash_params ||
+        header.num_layers != zs.size())
+        return false;
+    // Guard against hash collisions of the slicing parameters: Compare the slicing planes explicitly.
+    for (float z : zs)
+        if (float z_stored; ! reader.read(z_stored) || z_stored != z)
+            return false;
+
+    std::vector<ExPolygons> layers(zs.size());
+    for (ExPolygons &expolygons : layers) {
+        uint32_t num_expolygons;
+        if (! reader.read(num_expolygons))
+            return false;
+        expolygons.assign(num_expolygons, ExPolygon());
+        for (ExPolygon &expoly : expolygons) {
+            uint32_t num_holes;
+            if (! reader.read(num_holes) || ! reader.read(expoly.contour))
+                return false;
+            expoly.holes.assign(num_holes, Polygon());
+            for (Polygon &hole : expoly.holes)
+                if (! reader.read(hole))
+                    return false;
+        }
+    }
+    if (! reader.at_end())
+        return false;
+
+    // Mark the entry as recently used for the eviction. The cache directory may be read only, thus the failure is ignored.
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time(slice_cache_file_path(key), std::time(nullptr), ec);
+
+    out = std::move(layers);
+    return true;
+}
+
+void slice_cache_store(const SliceCacheKey &key, const std::vector<float> &zs, const std::vector<ExPolygons> &layers)
+{
+    assert(zs.size() == layers.size());
+    if (! slice_cache_enabled())
+        return;
+
+    SliceCacheWriter writer;
+    writer.write(SliceCacheHeader{ SLICE_CACHE_MAGIC, SLICE_CACHE_VERSION, uint32_t(sizeof(coord_t)), 0, key.hash_mesh, key.hash_params, uint64_t(zs.size()) });
+    for (float z : zs)
+        writer.write(z);
+    for (const ExPolygons &expolygons : layers) {
+        writer.write<uint32_t>(uint32_t(expolygons.size()));
+        for (const ExPolygon &expoly : expolygons) {
+            writer.write<uint32_t>(uint32_t(expoly.holes.size()));
+            writer.write(expoly.contour);
+            for (const Polygon &hole : expoly.holes)
+                writer.write(hole);
+        }
+    }
+
+    // Write into a temporary file first, then rename, so that concurrent readers never see a partially written entry.
+    const std::string path     = slice_cache_file_path(key);
+    const std::string path_tmp = path + "." + boost::filesystem::unique_path().string() + ".tmp";
+    {
+        boost::nowide::ofstream ofs(path_tmp, std::ios::binary);
+        ofs.write(writer.data().data(), std::streamsize(writer.data().size()));
+        ofs.close();
+        if (ofs.fail()) {
+            BOOST_LOG_TRIVIAL(error) << "Failed to write slice cache entry " << path_tmp;
+            boost::system::error_code ec;
+            boost::filesystem::remove(path_tmp, ec);
+            return;
+        }
+    }
+    if (std::error_code ec = rename_file(path_tmp, path); ec) {
+        BOOST_LOG_TRIVIAL(error) << "Failed to rename slice cache entry " << path_tmp << " to " << path << ": " << ec.message();
+        boost::system::error_code ec2;
+        boost::filesystem::remove(path_tmp, ec2);
+        return;
+    }
+    slice_cache_evict(path);
+}
+
+std::vector<ExPolygons> slice_mesh_ex_cached(
+    const indexed_triangle_set       &mesh,
+    const std::vector<float>         &zs,
+    const MeshSlicingParamsEx        &params,
+    std::function<void()>             throw_on_cancel)
+{
+    if (! slice_cache_enabled() || zs.empty())
+        return slice_mesh_ex(mesh, zs, params, throw_on_cancel);
+
+    const SliceCacheKey     key = slice_cache_key(mesh, zs, params);
+    std::vector<ExPolygons> layers;
+    if (slice_cache_load(key, zs, layers)) {
+        BOOST_LOG_TRIVIAL(debug) << "Slice cache hit " << key.to_string();
+        return layers;
+    }
+    layers = slice_mesh_ex(mesh, zs, params, throw_on_cancel);
+    // Don't store possibly incomplete results if the slicing was canceled.
+    throw_on_cancel();
+    slice_cache_store(key, zs, layers);
+    return layers;
+}
+
+} // namespace Slic3r
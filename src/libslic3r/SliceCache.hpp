@@ -0,0 +1,60 @@
+#ifndef slic3r_SliceCache_hpp_
+#define slic3r_SliceCache_hpp_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ExPolygon.hpp"
+#include "TriangleMeshSlicer.hpp"
+
+struct indexed_triangle_set;
+
+namespace Slic3r {
+
+// Persistent on-disk cache of the slice_mesh_ex() results.
+// The cached layers are addressed by a hash of everything slice_mesh_ex() depends on: the triangle set,
+// the slicing Z coordinates (thus also the SlicingParameters they were generated from) and MeshSlicingParamsEx
+// including the transformation. Each entry is stored in its own compact binary file, so that the cache
+// may be shared by multiple processes slicing the same meshes with only G-code level settings changed.
+// The modification time of an entry is updated whenever it is loaded, thus the least recently used entries
+// are evicted first once the cache grows over its size limit.
+
+// Set the directory of the slice cache. Empty path disables the cache (the default).
+void                set_slice_cache_dir(const std::string &path);
+// Return the directory of the slice cache, empty if the cache is disabled.
+const std::string&  slice_cache_dir();
+inline bool         slice_cache_enabled() { return ! slice_cache_dir().empty(); }
+// Set the limit of the total size of the cache entries in bytes, checked whenever a new entry is stored. Zero for no limit.
+void                set_slice_cache_max_size(size_t size);
+size_t              slice_cache_max_size();
+
+struct SliceCacheKey
+{
+    uint64_t hash_mesh   { 0 };
+    uint64_t hash_params { 0 };
+
+    bool        operator==(const SliceCacheKey &rhs) const { return hash_mesh == rhs.hash_mesh && hash_params == rhs.hash_params; }
+    // 32 hex digits, used as a file name of the cache entry.
+    std::string to_string() const;
+};
+
+SliceCacheKey       slice_cache_key(const indexed_triangle_set &mesh, const std::vector<float> &zs, const MeshSlicingParamsEx &params);
+
+// Load layers stored under the given key. Returns false if the entry does not exist or if it is damaged or incompatible.
+bool                slice_cache_load(const SliceCacheKey &key, const std::vector<float> &zs, std::vector<ExPolygons> &out);
+// Store layers under the given key, then evict the least recently used entries if the cache is over its size limit.
+// Failure to write the cache entry is logged, but otherwise ignored.
+void                slice_cache_store(const SliceCacheKey &key, const std::vector<float> &zs, const std::vector<ExPolygons> &layers);
+
+// Drop-in replacement of slice_mesh_ex(), which consults the slice cache if enabled.
+std::vector<ExPolygons> slice_mesh_ex_cached(
+    const indexed_triangle_set       &mesh,
+    const std::vector<float>         &zs,
+    const MeshSlicingParamsEx        &params,
+    std::function<void()>             throw_on_cancel = []{});
+
+} // namespace Slic3r
+
+#endif // slic3r_SliceCache_hpp_
@@ -0,0 +1,153 @@
+#include "CollisionDistanceField.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "libslic3r/BoundingBox.hpp"
+
+namespace Slic3r
+{
+
+namespace FFFTreeSupport
+{
+
+CollisionDistanceField::CollisionDistanceField(const Polygons &polygons, double max_distance, double resolution)
+{
+    assert(max_distance >= 0.);
+    assert(resolution > 0.);
+    for (const Polygon &polygon : polygons)
+        for (size_t i = 0; i < polygon.size(); ++ i) {
+            const Point &a = polygon.points[i];
+            const Point &b = polygon.points[i + 1 == polygon.size() ? 0 : i + 1];
+            if (a != b)
+                m_lines.push_back({ unscaled<double>(a), unscaled<double>(b) });
+        }
+    if (m_lines.empty())
+        return;
+
+    BoundingBoxf bbox;
+    for (const Linef &line : m_lines) {
+        bbox.merge(line.a);
+        bbox.merge(line.b);
+    }
+    bbox.offset(max_distance + resolution);
+    m_resolution     = resolution;
+    m_inv_resolution = 1. / resolution;
+    m_origin         = bbox.min;
+    m_cols           = int(std::ceil(bbox.size().x() * m_inv_resolution)) + 1;
+    m_rows           = int(std::ceil(bbox.size().y() * m_inv_resolution)) + 1;
+    m_tile_cols      = (m_cols + TileSize - 1) / TileSize;
+    m_tile_rows      = (m_rows + TileSize - 1) / TileSize;
+    m_tile_map.assign(size_t(m_tile_cols) * size_t(m_tile_rows), 0);
+
+    // Calls fn(ix, iy) for all cells of a grid with the given cell size containing points sampled along the line with the given step
+    // and for their neighbors up to dist.
+    auto visit_cells_around_line = [this](const Linef &line, double step, double dist, double cell_size, int cols, int rows, auto fn) {
+        const Vec2d  v     = line.b - line.a;
+        const size_t n     = size_t(std::ceil(v.norm() / step)) + 1;
+        const int    ndist = int(std::ceil(dist / cell_size));
+        for (size_t i = 0; i < n; ++ i) {
+            const Vec2d p  = line.a + v * (n == 1 ? 0. : double(i) / double(n - 1));
+            const int   cx = int(std::floor((p.x() - m_origin.x()) / cell_size));
+            const int   cy = int(std::floor((p.y() - m_origin.y()) / cell_size));
+            for (int iy = std::max(0, cy - ndist); iy <= std::min(rows - 1, cy + ndist); ++ iy)
+                for (int ix = std::max(0, cx - ndist); ix <= std::min(cols - 1, cx + ndist); ++ ix)
+                    fn(ix, iy);
+        }
+    };
+
+    // Allocate the tiles closer than max_distance to the lines. Sampling the lines by the tile size, any point closer than
+    // max_distance to a line is closer than max_distance + tile size to a sample.
+    {
+        const double tile_size = TileSize * resolution;
+        for (const Linef &line : m_lines)
+            visit_cells_around_line(line, tile_size, max_distance + tile_size, tile_size, m_tile_cols, m_tile_rows,
+                [this](int tx, int ty) { m_tile_map[ty * m_tile_cols + tx] = 1; });
+        uint32_t num_tiles = 0;
+        for (uint32_t &t : m_tile_map)
+            if (t)
+                t = ++ num_tiles;
+        m_cells.assign(size_t(num_tiles) * TileSize * TileSize, NoLine);
+    }
+
+    // Squared distances of the cell centers to their closest lines, only needed during the construction.
+    std::vector<float> sqr_distances(m_cells.size(), std::numeric_limits<float>::max());
+    auto update_cell = [this, &sqr_distances](int ix, int iy, uint32_t line_idx) {
+        if (int tile = this->tile_idx(ix, iy); tile >= 0) {
+            const size_t idx = this->cell_idx(tile, ix, iy);
+            const float  d2  = float(line_alg::distance_to_squared(m_lines[line_idx], this->cell_center(ix, iy)));
+            if (d2 < sqr_distances[idx]) {
+                sqr_distances[idx] = d2;
+                m_cells[idx] = line_idx;
+            }
+        }
+    };
+
+    // Seed the cells along the lines with their exact closest lines.
+    for (uint32_t line_idx = 0; line_idx < uint32_t(m_lines.size()); ++ line_idx)
+        visit_cells_around_line(m_lines[line_idx], 0.5 * resolution, resolution, resolution, m_cols, m_rows,
+            [line_idx, &update_cell](int ix, int iy) { update_cell(ix, iy, line_idx); });
+
+    // Propagate the closest lines to the rest of the allocated cells in a forward and a backward raster pass.
+    auto propagate = [this, &update_cell](int ix, int iy, int dx, int dy) {
+        const int jx = ix + dx;
+        const int jy = iy + dy;
+        if (jx >= 0 && jx < m_cols && jy >= 0 && jy < m_rows)
+            if (int tile = this->tile_idx(jx, jy); tile >= 0)
+                if (uint32_t line_idx = m_cells[this->cell_idx(tile, jx, jy)]; line_idx != NoLine)
+                    update_cell(ix, iy, line_idx);
+    };
+    for (int iy = 0; iy < m_rows; ++ iy)
+        for (int ix = 0; ix < m_cols; ++ ix)
+            if (this->tile_idx(ix, iy) >= 0) {
+                propagate(ix, iy, -1, -1);
+                propagate(ix, iy,  0, -1);
+                propagate(ix, iy,  1, -1);
+                propagate(ix, iy, -1,  0);
+            }
+    for (int iy = m_rows - 1; iy >= 0; -- iy)
+        for (int ix = m_cols - 1; ix >= 0; -- ix)
+            if (this->tile_idx(ix, iy) >= 0) {
+                propagate(ix, iy,  1,  1);
+                propagate(ix, iy,  0,  1);
+                propagate(ix, iy, -1,  1);
+                propagate(ix, iy,  1,  0);
+            }
+}
+
+double CollisionDistanceField::squared_distance(const Vec2d &point, Vec2d &hit_point_out, double max_sqr_dist) const
+{
+    if (m_lines.empty())
+        return -1.;
+    // Cell, whose center is the bottom left of the four cell centers surrounding the point.
+    const double fx = (point.x() - m_origin.x()) * m_inv_resolution - 0.5;
+    const double fy = (point.y() - m_origin.y()) * m_inv_resolution - 0.5;
+    if (fx < -1. || fy < -1. || fx >= m_cols || fy >= m_rows)
+        // Outside of the grid, further than max_distance from all the lines.
+        return -1.;
+    const int x0 = int(std::floor(fx));
+    const int y0 = int(std::floor(fy));
+    double    out = -1.;
+    uint32_t  tested[4];
+    int       num_tested = 0;
+    for (int iy = std::max(0, y0); iy <= std::min(m_rows - 1, y0 + 1); ++ iy)
+        for (int ix = std::max(0, x0); ix <= std::min(m_cols - 1, x0 + 1); ++ ix)
+            if (int tile = this->tile_idx(ix, iy); tile >= 0)
+                if (uint32_t line_idx = m_cells[this->cell_idx(tile, ix, iy)];
+                    line_idx != NoLine && std::find(tested, tested + num_tested, line_idx) == tested + num_tested) {
+                    tested[num_tested ++] = line_idx;
+                    Vec2d  hit_point;
+                    double d2 = line_alg::distance_to_squared(m_lines[line_idx], point, &hit_point);
+                    if (d2 < max_sqr_dist && (out < 0. || d2 < out)) {
+                        out = d2;
+                        hit_point_out = hit_point;
+                    }
+                }
+    return out;
+}
+
+} // namespace FFFTreeSupport
+
+} // namespace Slic3r
@@ -0,0 +1,73 @@
+#ifndef slic3r_CollisionDistanceField_hpp
+#define slic3r_CollisionDistanceField_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "libslic3r/Line.hpp"
+#include "libslic3r/Point.hpp"
+#include "libslic3r/Polygon.hpp"
+
+namespace Slic3r
+{
+
+namespace FFFTreeSupport
+{
+
+// Distance to the edges of the collision polygons of a single layer, precalculated on a regular grid.
+// Each grid cell stores the index of the edge closest to the cell center, which is calculated by a feature transform
+// (propagating the closest edges from the neighbor cells in two raster passes). The closest edge to any point is then
+// found in constant time by testing the edges of the four cells around the point, independently of the number of edges
+// and of the radius of the query. Only the tiles of cells closer than max_distance to some edge are allocated.
+// Alternative to the AABB tree over the collision polygon edges, used for smoothing the organic support branches.
+class CollisionDistanceField
+{
+public:
+    CollisionDistanceField() = default;
+    // Polygons in scaled coordinates, max_distance and resolution (size of a grid cell) in millimeters.
+    // Queries are answered exactly up to the imprecision of the feature transform, which is below the grid resolution.
+    CollisionDistanceField(const Polygons &polygons, double max_distance, double resolution);
+
+    bool   empty() const { return m_lines.empty(); }
+    // Memory allocated by the grid, for benchmarking.
+    size_t memory_size() const { return m_lines.capacity() * sizeof(Linef) + m_tile_map.capacity() * sizeof(uint32_t) + m_cells.capacity() * sizeof(uint32_t); }
+
+    // Squared distance of an unscaled point to the closest polygon edge and the closest point on that edge.
+    // Returns -1 if no edge is closer than sqrt(max_sqr_dist), which shall not exceed the square of max_distance
+    // passed to the constructor. Same semantic as AABBTreeLines::squared_distance_to_indexed_lines().
+    double squared_distance(const Vec2d &point, Vec2d &hit_point_out, double max_sqr_dist) const;
+
+private:
+    // Number of cells along a side of a square tile.
+    static constexpr const int      TileSize = 16;
+    static constexpr const uint32_t NoLine   = uint32_t(-1);
+
+    // Index of the tile containing the cell or -1 if the tile is not allocated.
+    int      tile_idx(int ix, int iy) const {
+        uint32_t t = m_tile_map[(iy / TileSize) * m_tile_cols + ix / TileSize];
+        return int(t) - 1;
+    }
+    size_t   cell_idx(int tile, int ix, int iy) const { return size_t(tile) * (TileSize * TileSize) + (iy % TileSize) * TileSize + ix % TileSize; }
+    Vec2d    cell_center(int ix, int iy) const { return m_origin + Vec2d(ix + 0.5, iy + 0.5) * m_resolution; }
+
+    std::vector<Linef>      m_lines;
+    // Corner of the cell (0, 0).
+    Vec2d                   m_origin { Vec2d::Zero() };
+    double                  m_resolution { 1. };
+    double                  m_inv_resolution { 1. };
+    int                     m_cols { 0 };
+    int                     m_rows { 0 };
+    int                     m_tile_cols { 0 };
+    int                     m_tile_rows { 0 };
+    // One based index of a tile in m_cells, zero for tiles not allocated.
+    std::vector<uint32_t>   m_tile_map;
+    // Index of the closest line for each cell of the allocated tiles.
+    std::vector<uint32_t>   m_cells;
+};
+
+} // namespace FFFTreeSupport
+
+} // namespace Slic3r
+
+#endif // slic3r_CollisionDistanceField_hpp
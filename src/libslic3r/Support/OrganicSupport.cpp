@@ -26,6 +26,7 @@
 #include "libslic3r/Point.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Slicing.hpp"
+#include "libslic3r/Support/CollisionDistanceField.hpp"
 #include "libslic3r/Support/TreeModelVolumes.hpp"
 #include "libslic3r/Support/TreeSupport.hpp"
 #include "libslic3r/Support/TreeSupportCommon.hpp"
@@ -717,13 +718,25 @@ static void organic_smooth_branches_avoid_collisions(
     const std::vector<size_t>                           &linear_data_layers,
     std::function<void()>                                throw_on_cancel)
 {
+    // Collisions are tested either against the collision polygon edges indexed by an AABB tree, or against a distance field
+    // sampling the distance to the edges, which answers the queries in constant time.
+    const bool use_distance_field = print_object.config().support_tree_collision_mode == stcmDistanceField;
     struct LayerCollisionCache {
         coord_t          min_element_radius{ std::numeric_limits<coord_t>::max() };
         bool             min_element_radius_known() const { return this->min_element_radius != std::numeric_limits<coord_t>::max(); }
         coord_t          collision_radius{ 0 };
+        const Polygons  *collision{ nullptr };
         std::vector<Linef> lines;
         AABBTreeIndirect::Tree<2, double> aabbtree_lines;
-        bool             empty() const { return this->lines.empty(); }
+        CollisionDistanceField distance_field;
+        bool             empty() const { return this->lines.empty() && this->distance_field.empty(); }
+        // Squared distance to the closest collision edge and the closest point, or -1 if there is no edge closer than sqrt(max_sqr_dist).
+        double           squared_distance(const Vec2d &pt, Vec2d &hit_point_out, double max_sqr_dist) const {
+            if (! this->distance_field.empty())
+                return this->distance_field.squared_distance(pt, hit_point_out, max_sqr_dist);
+            size_t hit_idx_out;
+            return AABBTreeLines::squared_distance_to_indexed_lines(this->lines, this->aabbtree_lines, pt, hit_idx_out, hit_point_out, max_sqr_dist);
+        }
     };
     std::vector<LayerCollisionCache> layer_collision_cache;
     layer_collision_cache.reserve(1024);
@@ -750,6 +763,10 @@ static void organic_smooth_branches_avoid_collisions(
             std::optional<std::pair<coord_t, std::reference_wrapper<const Polygons>>> res = volumes.get_collision_lower_bound_area(layer_idx, l.min_element_radius);
             assert(res.has_value());
             l.collision_radius = res->first;
+            l.collision        = &res->second.get();
+            if (use_distance_field)
+                // Built once the extent of the collision spheres is known.
+                continue;
             Lines alines = to_lines(res->second.get());
             l.lines.reserve(alines.size());
             for (const Line &line : alines)
@@ -830,6 +847,24 @@ static void organic_smooth_branches_avoid_collisions(
 
     throw_on_cancel();
 
+    if (use_distance_field) {
+        // The distance fields only need to sample the distances up to the largest sphere intersecting a layer.
+        std::vector<float> max_sphere_radius(layer_collision_cache.size(), 0.f);
+        for (const CollisionSphere &collision_sphere : collision_spheres)
+            for (uint32_t layer_id = collision_sphere.layer_begin; layer_id < collision_sphere.layer_end; ++ layer_id)
+                max_sphere_radius[layer_id] = std::max(max_sphere_radius[layer_id], collision_sphere.radius);
+        // A fraction of the collision resolution, well below the precision of nudging the spheres.
+        static constexpr const double distance_field_resolution = 0.25;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, layer_collision_cache.size()),
+            [&layer_collision_cache, &max_sphere_radius, &throw_on_cancel](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id)
+                if (LayerCollisionCache &l = layer_collision_cache[layer_id]; l.collision != nullptr && max_sphere_radius[layer_id] > 0) {
+                    l.distance_field = CollisionDistanceField(*l.collision, max_sphere_radius[layer_id], distance_field_resolution);
+                    throw_on_cancel();
+                }
+        });
+    }
+
     static constexpr const double collision_extra_gap = 0.1;
     static constexpr const double max_nudge_collision_avoidance = 0.5;
     static constexpr const double max_nudge_smoothing = 0.2;
@@ -849,12 +884,10 @@ static void organic_smooth_branches_avoid_collisions(
                         double dz = (layer_id - collision_sphere.element.state.layer_idx) * slicing_params.layer_height;
                         if (double r2 = sqr(collision_sphere.radius) - sqr(dz); r2 > 0) {
                             if (const LayerCollisionCache &layer_collision_cache_item = layer_collision_cache[layer_id]; ! layer_collision_cache_item.empty()) {
-                                size_t hit_idx_out;
                                 Vec2d  hit_point_out;
-                                if (double dist = sqrt(AABBTreeLines::squared_distance_to_indexed_lines(
-                                    layer_collision_cache_item.lines, layer_collision_cache_item.aabbtree_lines, Vec2d(to_2d(collision_sphere.position).cast<double>()),
-                                    hit_idx_out, hit_point_out, r2)); dist >= 0.) {
-                                    double collision_depth = sqrt(r2) - dist;
+                                if (double dist2 = layer_collision_cache_item.squared_distance(Vec2d(to_2d(collision_sphere.position).cast<double>()), hit_point_out, r2);
+                                    dist2 >= 0.) {
+                                    double collision_depth = sqrt(r2) - sqrt(dist2);
                                     if (collision_depth > collision_sphere.last_collision_depth) {
                                         collision_sphere.last_collision_depth = collision_depth;
                                         collision_sphere.last_collision = to_3d(hit_point_out.cast<float>(), float(layer_z(slicing_params, config, layer_id)));
@@ -1087,8 +1120,8 @@ void organic_draw_branches(
 
     organic_smooth_branches_avoid_collisions(print_object, volumes, config, move_bounds, elements_with_link_down, linear_data_layers, throw_on_cancel);
 
-    // Reduce memory footprint. After this point only finalize_interface_and_support_areas() will use volumes and from that only collisions with zero radius will be used.
-    volumes.clear_all_but_object_collision();
+    // The volumes are not cleared to reduce the memory footprint here, as they are kept by the PrintObject
+    // to be reused by the next support generation, see PrintObject::tree_model_volumes_cache().
 
     // Unmark all nodes.
     for (SupportElements &elements : move_bounds)
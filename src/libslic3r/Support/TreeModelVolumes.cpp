@@ -14,6 +14,7 @@
 #include <oneapi/tbb/task_arena.h>
 #include <oneapi/tbb/task_group.h>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <numeric>
@@ -160,10 +161,38 @@ TreeModelVolumes::TreeModelVolumes(
 #endif
 }
 
+bool TreeModelVolumes::same_geometry(const TreeModelVolumes &other) const
+{
+    if (m_max_move != other.m_max_move || m_max_move_slow != other.m_max_move_slow || m_min_resolution != other.m_min_resolution ||
+        m_current_outline_idx != other.m_current_outline_idx || m_current_min_xy_dist != other.m_current_min_xy_dist ||
+        m_current_min_xy_dist_delta != other.m_current_min_xy_dist_delta || m_support_rests_on_model != other.m_support_rests_on_model ||
+        m_increase_until_radius != other.m_increase_until_radius || m_radius_0 != other.m_radius_0 || m_raft_layers != other.m_raft_layers ||
+        m_layer_outlines.size() != other.m_layer_outlines.size())
+        return false;
+    for (size_t i = 0; i < m_layer_outlines.size(); ++ i) {
+        // Only the settings used by calculateCollision().
+        const TreeSupportMeshGroupSettings &settings       = m_layer_outlines[i].first;
+        const TreeSupportMeshGroupSettings &other_settings = other.m_layer_outlines[i].first;
+        if (settings.layer_height != other_settings.layer_height || settings.support_xy_distance != other_settings.support_xy_distance ||
+            settings.support_top_distance != other_settings.support_top_distance || settings.support_bottom_distance != other_settings.support_bottom_distance)
+            return false;
+    }
+    // Compare the polygons last, they are the most expensive to compare.
+    if (m_machine_border != other.m_machine_border || m_anti_overhang != other.m_anti_overhang)
+        return false;
+    for (size_t i = 0; i < m_layer_outlines.size(); ++ i)
+        if (m_layer_outlines[i].second != other.m_layer_outlines[i].second)
+            return false;
+    return true;
+}
+
 void TreeModelVolumes::precalculate(const PrintObject& print_object, const coord_t max_layer, std::function<void()> throw_on_cancel)
 {
     auto t_start = std::chrono::high_resolution_clock::now();
     m_precalculated = true;
+    // The caches may have been filled in by a previous support generation, see same_geometry().
+    // Already calculated layers are skipped by the calculate*() functions.
+    m_ignorable_radii.clear();
 
     // Get the config corresponding to one mesh that is in the current group. Which one has to be irrelevant.
     // Not the prettiest way to do this, but it ensures some calculations that may be a bit more complex
@@ -856,12 +885,102 @@ coord_t TreeModelVolumes::ceilRadius(const coord_t radius) const
     return out;
 }
 
-void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layers)
+// Nanoseconds spent by all the caches waiting for m_insert_mutex.
+static std::atomic<int64_t> s_cache_insert_lock_wait_ns { 0 };
+
+double TreeModelVolumes::cache_insert_lock_wait_seconds()
+{
+    return double(s_cache_insert_lock_wait_ns.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+void TreeModelVolumes::reset_cache_insert_lock_wait()
+{
+    s_cache_insert_lock_wait_ns.store(0, std::memory_order_relaxed);
+}
+
+const TreeModelVolumes::RadiusLayerPolygonCache::Entry* TreeModelVolumes::RadiusLayerPolygonCache::LayerData::find(coord_t radius) const
+{
+    return this->find_if([radius](const Entry &entry) { return entry.radius == radius; });
+}
+
+const TreeModelVolumes::RadiusLayerPolygonCache::Entry* TreeModelVolumes::RadiusLayerPolygonCache::LayerData::find_lower_bound(coord_t radius) const
+{
+    const Entry *out = nullptr;
+    this->for_each([radius, &out](const Entry &entry) {
+        if (entry.radius <= radius && (out == nullptr || entry.radius > out->radius))
+            out = &entry;
+    });
+    return out;
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::LayerData::clear()
 {
-    if (num_layers > m_data.size()) {
-        if (num_layers > m_data.capacity())
-            reserve_power_of_2(m_data, num_layers);
-        m_data.resize(num_layers, {});
+    for (Chunk *chunk = this->head.load(std::memory_order_relaxed); chunk != nullptr;) {
+        Chunk *next = chunk->next.load(std::memory_order_relaxed);
+        delete chunk;
+        chunk = next;
+    }
+    this->head.store(nullptr, std::memory_order_relaxed);
+    this->size.store(0, std::memory_order_relaxed);
+}
+
+std::unique_lock<std::mutex> TreeModelVolumes::RadiusLayerPolygonCache::lock_for_insert()
+{
+    std::unique_lock<std::mutex> lock(m_insert_mutex, std::try_to_lock);
+    if (! lock.owns_lock()) {
+        const auto t_start = std::chrono::steady_clock::now();
+        lock.lock();
+        s_cache_insert_lock_wait_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_start).count(), std::memory_order_relaxed);
+    }
+    return lock;
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::emplace(LayerIndex layer_idx, coord_t radius, Polygons &&polygons)
+{
+    assert(layer_idx >= 0);
+    if (size_t(layer_idx) >= m_num_layers.load(std::memory_order_relaxed)) {
+        m_data.grow_to_at_least(size_t(layer_idx) + 1);
+        m_num_layers.store(m_data.size(), std::memory_order_release);
+    }
+    LayerData &layer = m_data[layer_idx];
+    if (layer.find(radius) != nullptr)
+        return;
+    // Find the chunk to receive the new entry, all the chunks before it are full.
+    const size_t         idx  = layer.size.load(std::memory_order_relaxed);
+    std::atomic<Chunk*> *link = &layer.head;
+    for (size_t i = idx / ChunkSize; i > 0; -- i)
+        link = &link->load(std::memory_order_relaxed)->next;
+    if (link->load(std::memory_order_relaxed) == nullptr)
+        link->store(new Chunk(), std::memory_order_release);
+    Entry &entry = link->load(std::memory_order_relaxed)->entries[idx % ChunkSize];
+    entry.radius   = radius;
+    entry.polygons = std::move(polygons);
+    // Publish the new entry.
+    layer.size.store(idx + 1, std::memory_order_release);
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear()
+{
+    m_data.clear();
+    m_num_layers.store(0, std::memory_order_relaxed);
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear_all_but_radius0()
+{
+    for (LayerData &layer : m_data) {
+        Entry *smallest = nullptr;
+        layer.for_each([&smallest](const Entry &entry) {
+            if (smallest == nullptr || entry.radius < smallest->radius)
+                smallest = const_cast<Entry*>(&entry);
+        });
+        if (smallest == nullptr)
+            continue;
+        Entry kept { smallest->radius, std::move(smallest->polygons) };
+        layer.clear();
+        layer.head.store(new Chunk(), std::memory_order_relaxed);
+        layer.head.load(std::memory_order_relaxed)->entries.front() = std::move(kept);
+        layer.size.store(1, std::memory_order_relaxed);
     }
 }
 
@@ -869,12 +988,11 @@ void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layer
 std::vector<std::pair<TreeModelVolumes::RadiusLayerPair, std::reference_wrapper<const Polygons>>> TreeModelVolumes::RadiusLayerPolygonCache::sorted() const
 {
     std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> out;
-    for (auto &layer : m_data) {
-        auto layer_idx = LayerIndex(&layer - m_data.data());
-        for (auto &radius_polygons : layer)
-            out.emplace_back(std::make_pair(radius_polygons.first, layer_idx), radius_polygons.second);
-    }
-    assert(std::is_sorted(out.begin(), out.end(), [](auto &l, auto &r){ return l.first.second < r.first.second || (l.first.second == r.first.second) && l.first.first < r.first.first; }));
+    for (size_t layer_idx = 0; layer_idx < m_num_layers.load(std::memory_order_acquire); ++ layer_idx)
+        m_data[layer_idx].for_each([&out, layer_idx](const Entry &entry) {
+            out.emplace_back(std::make_pair(entry.radius, LayerIndex(layer_idx)), entry.polygons);
+        });
+    std::sort(out.begin(), out.end(), [](auto &l, auto &r){ return l.first.second < r.first.second || (l.first.second == r.first.second && l.first.first < r.first.first); });
     return out;
 }
 
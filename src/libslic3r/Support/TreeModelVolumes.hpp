@@ -13,6 +13,8 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <functional>
@@ -24,6 +26,8 @@
 #include <cinttypes>
 #include <cstddef>
 
+#include <oneapi/tbb/concurrent_vector.h>
+
 #include "TreeSupportCommon.hpp"
 #include "../Point.hpp"
 #include "../Polygon.hpp"
@@ -80,6 +84,16 @@ public:
         m_wall_restrictions_cache_min.clear();
     }
 
+    // Are the collisions and avoidances calculated by this instance valid for other? True if both were constructed from the same
+    // object outlines, support blockers and support parameters affecting the collisions and avoidances, for example if just
+    // the support interfaces were modified. Used to reuse the caches between support generations of a PrintObject.
+    bool same_geometry(const TreeModelVolumes &other) const;
+
+    // Total time the insertions into the caches of all TreeModelVolumes waited for a lock, for benchmarking.
+    // The cache lookups do not lock.
+    static double cache_insert_lock_wait_seconds();
+    static void   reset_cache_insert_lock_wait();
+
     enum class AvoidanceType : int8_t
     {
         Slow,
@@ -205,43 +219,86 @@ private:
      * \brief Convenience typedef for the keys to the caches
      */
     using RadiusLayerPair             = std::pair<coord_t, LayerIndex>;
+    // Cache of polygons per layer and radius, read by many threads concurrently while being filled in.
+    // Lookups are lock-free, only the insertions are serialized by a mutex. References to the Polygons returned
+    // stay valid until clear() or clear_all_but_radius0() is called, as the stored Polygons are never moved.
     class RadiusLayerPolygonCache {
-        // Map from radius to Polygons. Cache of one layer collision regions.
-        using LayerData = std::map<coord_t, Polygons>;
-        // Vector of layers, at each layer map of radius to Polygons.
-        // Reference to Polygons returned shall be stable to insertion.
-        using Layers = std::vector<LayerData>;
+        struct Entry {
+            coord_t  radius { 0 };
+            Polygons polygons;
+        };
+        // Entries of a layer are stored in a linked list of fixed size chunks, which are never reallocated.
+        static constexpr const size_t ChunkSize = 8;
+        struct Chunk {
+            std::array<Entry, ChunkSize> entries;
+            std::atomic<Chunk*>          next { nullptr };
+        };
+        // Flat list of radii and their Polygons of a single layer, in the order of insertion. There are just tens of radii
+        // at most, thus a linear search is cheap. A writer fills in an entry before it publishes it by incrementing size.
+        struct LayerData {
+            LayerData() = default;
+            ~LayerData() { this->clear(); }
+            LayerData(const LayerData&) = delete;
+            LayerData& operator=(const LayerData&) = delete;
+
+            const Entry* find(coord_t radius) const;
+            // Entry with the largest radius lower or equal to the radius.
+            const Entry* find_lower_bound(coord_t radius) const;
+            // First entry satisfying the predicate.
+            template<typename Pred> const Entry* find_if(Pred pred) const {
+                size_t i = 0;
+                const size_t n = this->size.load(std::memory_order_acquire);
+                for (const Chunk *chunk = this->head.load(std::memory_order_acquire); i < n; chunk = chunk->next.load(std::memory_order_acquire))
+                    for (size_t j = 0; j < ChunkSize && i < n; ++ j, ++ i)
+                        if (pred(chunk->entries[j]))
+                            return &chunk->entries[j];
+                return nullptr;
+            }
+            template<typename Fn> void for_each(Fn fn) const {
+                this->find_if([&fn](const Entry &entry) { fn(entry); return false; });
+            }
+            // Not thread safe.
+            void clear();
+
+            std::atomic<Chunk*>  head { nullptr };
+            std::atomic<size_t>  size { 0 };
+        };
+
     public:
         RadiusLayerPolygonCache() = default;
-        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) : m_data(std::move(rhs.m_data)) {}
-        RadiusLayerPolygonCache& operator=(RadiusLayerPolygonCache &&rhs) { m_data = std::move(rhs.m_data); return *this; }
+        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) : m_data(std::move(rhs.m_data)), m_num_layers(rhs.m_num_layers.load()) { rhs.m_num_layers = 0; }
+        RadiusLayerPolygonCache& operator=(RadiusLayerPolygonCache &&rhs) {
+            m_data = std::move(rhs.m_data);
+            m_num_layers = rhs.m_num_layers.load();
+            rhs.m_num_layers = 0;
+            return *this;
+        }
 
         RadiusLayerPolygonCache(const RadiusLayerPolygonCache&) = delete;
         RadiusLayerPolygonCache& operator=(const RadiusLayerPolygonCache&) = delete;
 
+        // Polygons already stored for the same layer and radius are kept, as with std::map::emplace().
         void insert(std::vector<std::pair<RadiusLayerPair, Polygons>> &&in) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            std::unique_lock<std::mutex> lock = this->lock_for_insert();
             for (auto &d : in)
-                this->get_allocate_layer_data(d.first.second).emplace(d.first.first, std::move(d.second));
+                this->emplace(d.first.second, d.first.first, std::move(d.second));
         }
         // by layer
         void insert(std::vector<std::pair<coord_t, Polygons>> &&in, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            std::unique_lock<std::mutex> lock = this->lock_for_insert();
             for (auto &d : in)
-                this->get_allocate_layer_data(d.first).emplace(radius, std::move(d.second));
+                this->emplace(d.first, radius, std::move(d.second));
         }
         void insert(std::vector<Polygons> &&in, coord_t first_layer_idx, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            allocate_layers(first_layer_idx + in.size());
+            std::unique_lock<std::mutex> lock = this->lock_for_insert();
             for (auto &d : in)
-                m_data[first_layer_idx ++].emplace(radius, std::move(d));
+                this->emplace(first_layer_idx ++, radius, std::move(d));
         }
         void insert(LayerPolygonCache &&in, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            std::unique_lock<std::mutex> lock = this->lock_for_insert();
             LayerIndex i = in.begin();
-            allocate_layers(i + LayerIndex(in.size()));
             for (auto &d : in.polygons_mutable())
-                m_data[i ++].emplace(radius, std::move(d));
+                this->emplace(i ++, radius, std::move(d));
         }
         /*!
          * \brief Checks a cache for a given RadiusLayerPair and returns it if it is found
@@ -249,33 +306,21 @@ private:
          * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
          */
         std::optional<std::reference_wrapper<const Polygons>> getArea(const TreeModelVolumes::RadiusLayerPair &key) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-
-            if (key.second >= LayerIndex(m_data.size()))
+            if (key.second < 0 || size_t(key.second) >= m_num_layers.load(std::memory_order_acquire))
                 return std::nullopt;
-
-            const LayerData &layer = m_data[key.second];
-            auto it = layer.find(key.first);
-            if (it == layer.end())
+            const Entry *entry = m_data[key.second].find(key.first);
+            if (entry == nullptr)
                 return std::nullopt;
-
-            return std::optional<std::reference_wrapper<const Polygons>>{it->second};
+            return std::optional<std::reference_wrapper<const Polygons>>{entry->polygons};
         }
         // Get a collision area at a given layer for a radius that is a lower or equial to the key radius.
         std::optional<std::pair<coord_t, std::reference_wrapper<const Polygons>>> get_lower_bound_area(const TreeModelVolumes::RadiusLayerPair &key) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            if (key.second >= LayerIndex(m_data.size()))
+            if (key.second < 0 || size_t(key.second) >= m_num_layers.load(std::memory_order_acquire))
                 return {};
-            const auto &layer = m_data[key.second];
-            if (layer.empty())
+            const Entry *entry = m_data[key.second].find_lower_bound(key.first);
+            if (entry == nullptr)
                 return {};
-            auto it = layer.lower_bound(key.first);
-            if (it == layer.end() || it->first != key.first) {
-                if (it == layer.begin())
-                    return {};
-                -- it;
-            }
-            return std::make_pair(it->first, std::reference_wrapper<const Polygons>(it->second));
+            return std::make_pair(entry->radius, std::reference_wrapper<const Polygons>(entry->polygons));
         }
         /*!
          * \brief Get the highest already calculated layer in the cache.
@@ -285,10 +330,9 @@ private:
          * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
          */
         LayerIndex getMaxCalculatedLayer(coord_t radius) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            auto layer_idx = LayerIndex(m_data.size()) - 1;
+            auto layer_idx = LayerIndex(m_num_layers.load(std::memory_order_acquire)) - 1;
             for (; layer_idx > 0; -- layer_idx)
-                if (const auto &layer = m_data[layer_idx]; layer.find(radius) != layer.end())
+                if (m_data[layer_idx].find(radius) != nullptr)
                     break;
             // The placeable on model areas do not exist on layer 0, as there can not be model below it. As such it may be possible that layer 1 is available, but layer 0 does not exist.
             return layer_idx == 0 ? -1 : layer_idx;
@@ -297,25 +341,21 @@ private:
         // For debugging purposes, sorted by layer index, then by radius.
         [[nodiscard]] std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> sorted() const;
 
-        void clear() { m_data.clear(); }
-        void clear_all_but_radius0() { 
-            for (LayerData &l : m_data) {
-                auto begin = l.begin();
-                auto end = l.end();
-                if (begin != end && ++ begin != end)
-                    l.erase(begin, end);
-            }
-        }
+        // Not thread safe.
+        void clear();
+        // Keep the smallest radius of each layer only. Not thread safe.
+        void clear_all_but_radius0();
 
     private:
-        LayerData&          get_allocate_layer_data(LayerIndex layer_idx) {
-            allocate_layers(layer_idx + 1);
-            return m_data[layer_idx];
-        }
-        void                allocate_layers(size_t num_layers);
-
-        Layers              m_data;
-        mutable std::mutex  m_mutex;
+        std::unique_lock<std::mutex> lock_for_insert();
+        // Store polygons unless there are polygons for the same radius and layer already. m_insert_mutex has to be locked.
+        void                emplace(LayerIndex layer_idx, coord_t radius, Polygons &&polygons);
+
+        // Layers are only ever appended while holding m_insert_mutex, tbb::concurrent_vector does not move the existing ones.
+        // m_num_layers is published after the layers are constructed, the readers never access layers above it.
+        tbb::concurrent_vector<LayerData> m_data;
+        std::atomic<size_t>               m_num_layers { 0 };
+        std::mutex                        m_insert_mutex;
     };
 
 
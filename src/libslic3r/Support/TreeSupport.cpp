@@ -3464,11 +3464,21 @@ static void generate_support_areas(Print &print, const BuildVolume &build_volume
 #endif // SLIC3R_TREESUPPORT_PROGRESS
         PrintObject &print_object = *print.get_object(processing.second.front());
         // Generator for model collision, avoidance and internal guide volumes.
-        TreeModelVolumes volumes{ print_object, build_volume, config.maximum_move_distance, config.maximum_move_distance_slow, processing.second.front(),
+        // Reuse the collisions and avoidances calculated by the previous support generation of this object if the slices
+        // and the support parameters affecting them did not change, for example if just the support interfaces were modified.
+        std::shared_ptr<TreeModelVolumes> &cached_volumes = print_object.tree_model_volumes_cache();
+        {
+            TreeModelVolumes new_volumes{ print_object, build_volume, config.maximum_move_distance, config.maximum_move_distance_slow, processing.second.front(),
 #ifdef SLIC3R_TREESUPPORTS_PROGRESS
-            m_progress_multiplier, m_progress_offset, 
+                m_progress_multiplier, m_progress_offset, 
 #endif // SLIC3R_TREESUPPORTS_PROGRESS
-            /* additional_excluded_areas */{} };
+                /* additional_excluded_areas */{} };
+            if (cached_volumes && cached_volumes->same_geometry(new_volumes))
+                BOOST_LOG_TRIVIAL(info) << "Reusing the tree support collisions and avoidances of the previous support generation.";
+            else
+                cached_volumes = std::make_shared<TreeModelVolumes>(std::move(new_volumes));
+        }
+        TreeModelVolumes &volumes = *cached_volumes;
 
         //FIXME generating overhangs just for the furst mesh of the group.
         assert(processing.second.size() == 1);
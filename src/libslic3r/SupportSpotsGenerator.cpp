@@ -37,6 +37,7 @@
 #include "libslic3r/ExtrusionRole.hpp"
 #include "libslic3r/Flow.hpp"
 #include "libslic3r/LayerRegion.hpp"
+#include "libslic3r/Timer.hpp"
 
 // #define DETAILED_DEBUG_LOGS
 // #define DEBUG_FILES
@@ -823,9 +824,9 @@ public:
 
     ObjectPart &access(size_t id) { return this->active_object_parts.at(this->get_flat_id(id)); }
 
-    size_t insert(const ObjectPart &new_part)
+    size_t insert(ObjectPart &&new_part)
     {
-        this->active_object_parts.emplace(next_part_idx, new_part);
+        this->active_object_parts.emplace(next_part_idx, std::move(new_part));
         this->active_object_parts_id_mapping.emplace(next_part_idx, next_part_idx);
         return next_part_idx++;
     }
@@ -934,7 +935,7 @@ std::vector<EnitityToCheck> gather_entities_to_check(const Layer* layer) {
 
 LocalSupports compute_local_supports(
     const std::vector<EnitityToCheck>& entities_to_check,
-    const std::optional<Linesf>& previous_layer_boundary,
+    const AABBTreeLines::LinesDistancer<Linef>& prev_layer_boundary_distancer,
     const LD& prev_layer_ext_perim_lines,
     size_t slices_count,
     const Params& params
@@ -942,9 +943,6 @@ LocalSupports compute_local_supports(
     std::vector<tbb::concurrent_vector<ExtrusionLine>> unstable_lines_per_slice(slices_count);
     std::vector<tbb::concurrent_vector<ExtrusionLine>> ext_perim_lines_per_slice(slices_count);
 
-    AABBTreeLines::LinesDistancer<Linef> prev_layer_boundary_distancer =
-        (previous_layer_boundary ? AABBTreeLines::LinesDistancer<Linef>{*previous_layer_boundary} : AABBTreeLines::LinesDistancer<Linef>{});
-
     if constexpr (debug_files) {
         for (const auto &e_to_check : entities_to_check) {
             for (const auto &line : check_extrusion_entity_stability(e_to_check.e, e_to_check.region, prev_layer_ext_perim_lines,
@@ -993,9 +991,35 @@ std::optional<PartialObject> to_partial_object(const ObjectPart& part) {
     return {};
 }
 
+// Object parts formed by the extrusions of each slice alone. These do not depend on the layers below,
+// thus they are calculated for all the layers in parallel, leaving just the merging of the parts to the serial pass.
+using PrecomputedSliceParts = std::vector<std::vector<ObjectPart>>;
+PrecomputedSliceParts precompute_slices_parts(const PrintObject *po, const Params &params, const PrintTryCancel &cancel_func)
+{
+    PrecomputedSliceParts result(po->layer_count());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, po->layer_count()), [po, &params, &cancel_func, &result](tbb::blocked_range<size_t> r) {
+        for (size_t lidx = r.begin(); lidx < r.end(); ++lidx) {
+            cancel_func();
+            const Layer *layer            = po->get_layer(lidx);
+            const bool   connected_to_bed = int(layer->id()) == params.raft_layers_count;
+            const bool   with_brim        = has_brim(layer, params);
+            std::vector<ObjectPart> &parts = result[lidx];
+            parts.reserve(layer->lslices_ex.size());
+            for (size_t slice_idx = 0; slice_idx < layer->lslices_ex.size(); ++slice_idx)
+                parts.emplace_back(
+                    gather_extrusions(layer->lslices_ex[slice_idx], layer),
+                    connected_to_bed,
+                    layer->print_z,
+                    layer->height,
+                    with_brim ? std::optional{get_brim(layer->lslices[slice_idx], params.brim_type, params.brim_width)} : std::nullopt);
+        }
+    });
+    return result;
+}
+
 SliceMappings update_active_object_parts(const Layer                        *layer,
-                                         const Params                       &params,
                                          const std::vector<SliceConnection> &precomputed_slice_connections,
+                                         std::vector<ObjectPart>           &&precomputed_slice_parts,
                                          const SliceMappings                &previous_slice_mappings,
                                          ActiveObjectParts                  &active_object_parts,
                                          PartialObjects                     &partial_objects)
@@ -1004,21 +1028,7 @@ SliceMappings update_active_object_parts(const Layer                        *lay
 
     for (size_t slice_idx = 0; slice_idx < layer->lslices_ex.size(); ++slice_idx) {
         const LayerSlice &slice             = layer->lslices_ex.at(slice_idx);
-        const std::vector<const ExtrusionEntityCollection*> extrusion_collections{gather_extrusions(slice, layer)};
-        const bool connected_to_bed = int(layer->id()) == params.raft_layers_count;
-
-        const std::optional<Polygons> brim{
-             has_brim(layer, params) ?
-             std::optional{get_brim(layer->lslices[slice_idx], params.brim_type, params.brim_width)} :
-             std::nullopt
-        };
-        ObjectPart new_part{
-            extrusion_collections,
-            connected_to_bed,
-            layer->print_z,
-            layer->height,
-            brim
-        };
+        ObjectPart       &new_part          = precomputed_slice_parts[slice_idx];
 
         const SliceConnection &connection_to_below = precomputed_slice_connections[slice_idx];
 
@@ -1031,7 +1041,7 @@ SliceMappings update_active_object_parts(const Layer                        *lay
 #endif
 
         if (connection_to_below.area < EPSILON) { // new object part emerging
-            size_t part_id = active_object_parts.insert(new_part);
+            size_t part_id = active_object_parts.insert(std::move(new_part));
             new_slice_mappings.index_to_object_part_mapping.emplace(slice_idx, part_id);
             new_slice_mappings.index_to_weakest_connection.emplace(slice_idx, connection_to_below);
         } else {
@@ -1120,6 +1130,7 @@ void reckon_global_supports(const tbb::concurrent_vector<ExtrusionLine> &externa
 
 std::tuple<SupportPoints, PartialObjects> check_stability(const PrintObject                 *po,
                                                           const PrecomputedSliceConnections &precomputed_slices_connections,
+                                                          PrecomputedSliceParts            &&precomputed_slices_parts,
                                                           const PrintTryCancel              &cancel_func,
                                                           const Params                      &params)
 {
@@ -1128,26 +1139,35 @@ std::tuple<SupportPoints, PartialObjects> check_stability(const PrintObject
     ActiveObjectParts active_object_parts{};
     PartialObjects    partial_objects{};
     LD                prev_layer_ext_perim_lines;
+    const AABBTreeLines::LinesDistancer<Linef> no_lower_layer;
 
     SliceMappings slice_mappings;
 
+    // Time spent in the phases of the serial pass, for profiling.
+    Timing::Timer timer;
+    double        time_merge_parts     = 0.;
+    double        time_local_supports  = 0.;
+    double        time_global_supports = 0.;
 
     for (size_t layer_idx = 0; layer_idx < po->layer_count(); ++layer_idx) {
         cancel_func();
         const Layer *layer                 = po->get_layer(layer_idx);
         float        bottom_z              = layer->bottom_z();
 
-        slice_mappings = update_active_object_parts(layer, params, precomputed_slices_connections[layer_idx], slice_mappings, active_object_parts, partial_objects);
-
-        std::optional<Linesf> prev_layer_boundary = layer->lower_layer != nullptr ?
-                                                        std::optional{to_unscaled_linesf(layer->lower_layer->lslices)} :
-                                                        std::nullopt;
+        timer.start();
+        slice_mappings = update_active_object_parts(layer, precomputed_slices_connections[layer_idx], std::move(precomputed_slices_parts[layer_idx]),
+                                                    slice_mappings, active_object_parts, partial_objects);
+        time_merge_parts += timer.elapsed_seconds();
 
+        timer.start();
         LocalSupports local_supports{
-            compute_local_supports(gather_entities_to_check(layer), prev_layer_boundary, prev_layer_ext_perim_lines, layer->lslices_ex.size(), params)};
+            compute_local_supports(gather_entities_to_check(layer), layer->lower_layer != nullptr ? layer->lower_layer->lslices_distancer() : no_lower_layer,
+                                   prev_layer_ext_perim_lines, layer->lslices_ex.size(), params)};
+        time_local_supports += timer.elapsed_seconds();
 
         std::vector<ExtrusionLine> current_layer_ext_perims_lines{};
         current_layer_ext_perims_lines.reserve(prev_layer_ext_perim_lines.get_lines().size());
+        timer.start();
         // All object parts updated, and for each slice we have coresponding weakest connection.
         // We can now check each slice and its corresponding weakest connection and object part for stability.
         for (size_t slice_idx = 0; slice_idx < layer->lslices_ex.size(); ++slice_idx) {
@@ -1171,8 +1191,12 @@ std::tuple<SupportPoints, PartialObjects> check_stability(const PrintObject
             current_layer_ext_perims_lines.insert(current_layer_ext_perims_lines.end(), external_perimeter_lines.begin(), external_perimeter_lines.end());
         } // slice iterations
         prev_layer_ext_perim_lines = LD(current_layer_ext_perims_lines);
+        time_global_supports += timer.elapsed_seconds();
     } // layer iterations
 
+    BOOST_LOG_TRIVIAL(debug) << "SupportSpotsGenerator: merging object parts " << time_merge_parts << " s, local supports " << time_local_supports <<
+        " s, global supports " << time_global_supports << " s";
+
     for (const auto& active_obj_pair : slice_mappings.index_to_object_part_mapping) {
         auto object_part = active_object_parts.access(active_obj_pair.second);
         if (auto object = to_partial_object(object_part)) {
@@ -1225,8 +1249,16 @@ void debug_export(const SupportPoints& support_points,const PartialObjects& obje
 
 std::tuple<SupportPoints, PartialObjects> full_search(const PrintObject *po, const PrintTryCancel& cancel_func, const Params &params)
 {
+    // The properties of the slices of each layer are independent of the other layers and they are calculated in parallel.
+    // Only the propagation of the object parts and of the weakest connections from the bottom up is serial.
+    Timing::Timer timer;
+    timer.start();
     auto precomputed_slices_connections = precompute_slices_connections(po);
-    auto results = check_stability(po, precomputed_slices_connections, cancel_func, params);
+    auto precomputed_slices_parts       = precompute_slices_parts(po, params, cancel_func);
+    BOOST_LOG_TRIVIAL(debug) << "SupportSpotsGenerator: per layer precalculation " << timer.elapsed_seconds() << " s";
+    timer.start();
+    auto results = check_stability(po, precomputed_slices_connections, std::move(precomputed_slices_parts), cancel_func, params);
+    BOOST_LOG_TRIVIAL(debug) << "SupportSpotsGenerator: stability check " << timer.elapsed_seconds() << " s";
 #ifdef DEBUG_FILES
     auto [supp_points, objects] = results;
     debug_export(supp_points, objects, "issues");
@@ -1317,11 +1349,11 @@ void estimate_malformations(LayerPtrs &layers, const Params &params)
 #endif
 
     LD prev_layer_lines{};
+    const AABBTreeLines::LinesDistancer<Linef> no_lower_layer;
 
     for (Layer *l : layers) {
         l->curled_lines.clear();
-        std::vector<Linef> boundary_lines = l->lower_layer != nullptr ? to_unscaled_linesf(l->lower_layer->lslices) : std::vector<Linef>();
-        AABBTreeLines::LinesDistancer<Linef> prev_layer_boundary{std::move(boundary_lines)};
+        const AABBTreeLines::LinesDistancer<Linef> &prev_layer_boundary = l->lower_layer != nullptr ? l->lower_layer->lslices_distancer() : no_lower_layer;
         std::vector<ExtrusionLine>           current_layer_lines;
         for (const LayerRegion *layer_region : l->regions()) {
             for (const ExtrusionEntity *extrusion : layer_region->perimeters().flatten().entities) {
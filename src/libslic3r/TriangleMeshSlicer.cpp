@@ -415,40 +415,83 @@ private:
     std::array<CacheLineAlignedMutex, 64> m_mutexes;
 };
 
-template<typename TransformVertex>
-void slice_facet_at_zs(
+// Number of facets processed by slice_facets_at_zs() at once.
+static constexpr const int SLICE_FACETS_BATCH_SIZE = 512;
+
+// Slice a batch of facets [face_begin, face_end) with a sorted set of slicing planes.
+// The Z coordinates of the facet vertices are gathered into a structure of arrays first, so that the facet Z extents
+// are calculated by a loop that the compiler vectorizes and the facets not crossing any slicing plane are rejected cheaply.
+// The intersection lines are collected locally and then appended to the output with a single lock per slice touched by the batch.
+template<typename TransformVertex, typename FacetColor>
+void slice_facets_at_zs(
     // Scaled or unscaled vertices. transform_vertex_fn may scale zs.
     const std::vector<Vec3f>                         &mesh_vertices,
     const TransformVertex                            &transform_vertex_fn,
-    const stl_triangle_vertex_indices                &indices,
-    const Vec3i                                      &edge_ids,
-    const ColorPolygon::Color                         facet_color,
+    const std::vector<stl_triangle_vertex_indices>   &mesh_faces,
+    const std::vector<Vec3i>                         &face_edge_ids,
+    const FacetColor                                 &facet_color_fn,
+    const int                                         face_begin,
+    const int                                         face_end,
     // Scaled or unscaled zs. If vertices have their zs scaled or transform_vertex_fn scales them, then zs have to be scaled as well.
     const std::vector<float>                         &zs,
+    std::vector<std::pair<size_t, IntersectionLine>> &lines_batch,
     std::vector<IntersectionLines>                   &lines,
     LinesMutexes                                     &lines_mutex)
 {
-    stl_vertex vertices[3] { transform_vertex_fn(mesh_vertices[indices(0)]), transform_vertex_fn(mesh_vertices[indices(1)]), transform_vertex_fn(mesh_vertices[indices(2)]) };
+    assert(face_end - face_begin <= SLICE_FACETS_BATCH_SIZE);
+    const int  num_faces = face_end - face_begin;
+    stl_vertex vertices[SLICE_FACETS_BATCH_SIZE][3];
+    float      z[3][SLICE_FACETS_BATCH_SIZE];
+    float      min_z[SLICE_FACETS_BATCH_SIZE];
+    float      max_z[SLICE_FACETS_BATCH_SIZE];
+
+    for (int i = 0; i < num_faces; ++ i) {
+        const stl_triangle_vertex_indices &indices = mesh_faces[face_begin + i];
+        for (int j = 0; j < 3; ++ j) {
+            vertices[i][j] = transform_vertex_fn(mesh_vertices[indices(j)]);
+            z[j][i]        = vertices[i][j].z();
+        }
+    }
+    // Find facet extents. Branch free, vectorized.
+    for (int i = 0; i < num_faces; ++ i) {
+        min_z[i] = std::min(z[0][i], std::min(z[1][i], z[2][i]));
+        max_z[i] = std::max(z[0][i], std::max(z[1][i], z[2][i]));
+    }
 
-    // find facet extents
-    const float min_z = fminf(vertices[0].z(), fminf(vertices[1].z(), vertices[2].z()));
-    const float max_z = fmaxf(vertices[0].z(), fmaxf(vertices[1].z(), vertices[2].z()));
-    
-    // find layer extents
-    auto min_layer = std::lower_bound(zs.begin(), zs.end(), min_z); // first layer whose slice_z is >= min_z
-    auto max_layer = std::upper_bound(min_layer, zs.end(), max_z); // first layer whose slice_z is > max_z
-    int  idx_vertex_lowest = (vertices[1].z() == min_z) ? 1 : ((vertices[2].z() == min_z) ? 2 : 0);
-    
-    for (auto it = min_layer; it != max_layer; ++ it) {
-        IntersectionLine il;
+    lines_batch.clear();
+    const float z_first = zs.front();
+    const float z_last  = zs.back();
+    for (int i = 0; i < num_faces; ++ i) {
         // Ignore horizontal triangles. Any valid horizontal triangle must have a vertical triangle connected, otherwise the part has zero volume.
-        if (min_z != max_z && slice_facet(*it, vertices, indices, edge_ids, idx_vertex_lowest, false, facet_color, il) == FacetSliceType::Slicing) {
-            assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
-            size_t slice_id = it - zs.begin();
-            boost::lock_guard<std::mutex> l(lines_mutex(slice_id));
-            lines[slice_id].emplace_back(il);
+        // Ignore triangles not crossing any slicing plane.
+        if (min_z[i] == max_z[i] || max_z[i] < z_first || min_z[i] > z_last)
+            continue;
+        // find layer extents
+        auto min_layer = std::lower_bound(zs.begin(), zs.end(), min_z[i]); // first layer whose slice_z is >= min_z
+        auto max_layer = std::upper_bound(min_layer, zs.end(), max_z[i]); // first layer whose slice_z is > max_z
+        if (min_layer == max_layer)
+            continue;
+        const int                          face_idx          = face_begin + i;
+        const stl_triangle_vertex_indices &indices           = mesh_faces[face_idx];
+        const int                          idx_vertex_lowest = (z[1][i] == min_z[i]) ? 1 : ((z[2][i] == min_z[i]) ? 2 : 0);
+        for (auto it = min_layer; it != max_layer; ++ it) {
+            IntersectionLine il;
+            if (slice_facet(*it, vertices[i], indices, face_edge_ids[face_idx], idx_vertex_lowest, false, facet_color_fn(face_idx), il) == FacetSliceType::Slicing) {
+                assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
+                lines_batch.emplace_back(size_t(it - zs.begin()), il);
+            }
         }
     }
+
+    // Append the lines to the output, one lock per slice.
+    std::stable_sort(lines_batch.begin(), lines_batch.end(), [](const auto &l, const auto &r) { return l.first < r.first; });
+    for (auto it = lines_batch.begin(); it != lines_batch.end();) {
+        const size_t slice_id = it->first;
+        auto         it_end   = std::find_if(it, lines_batch.end(), [slice_id](const auto &l) { return l.first != slice_id; });
+        boost::lock_guard<std::mutex> l(lines_mutex(slice_id));
+        for (; it != it_end; ++ it)
+            lines[slice_id].emplace_back(it->second);
+    }
 }
 
 template<AdditionalMeshInfo mesh_info, typename TransformVertex, typename ThrowOnCancel>
@@ -462,14 +505,17 @@ static inline std::vector<IntersectionLines> slice_make_lines(
     const ThrowOnCancel                              throw_on_cancel_fn)
 {
     std::vector<IntersectionLines> lines(zs.size(), IntersectionLines{});
+    if (zs.empty())
+        return lines;
     LinesMutexes                   lines_mutex;
     tbb::parallel_for(
-        tbb::blocked_range<int>(0, int(indices.size())),
+        tbb::blocked_range<int>(0, int(indices.size()), SLICE_FACETS_BATCH_SIZE),
         [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &facet_color_fn, &zs, &lines, &lines_mutex, throw_on_cancel_fn](const tbb::blocked_range<int> &range) {
-            for (int face_idx = range.begin(); face_idx < range.end(); ++ face_idx) {
-                if ((face_idx & 0x0ffff) == 0)
-                    throw_on_cancel_fn();
-                slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx], face_edge_ids[face_idx], facet_color_fn(face_idx), zs, lines, lines_mutex);
+            std::vector<std::pair<size_t, IntersectionLine>> lines_batch;
+            for (int face_begin = range.begin(); face_begin < range.end(); face_begin += SLICE_FACETS_BATCH_SIZE) {
+                throw_on_cancel_fn();
+                slice_facets_at_zs(vertices, transform_vertex_fn, indices, face_edge_ids, facet_color_fn,
+                    face_begin, std::min(face_begin + SLICE_FACETS_BATCH_SIZE, range.end()), zs, lines_batch, lines, lines_mutex);
             }
         }
     );
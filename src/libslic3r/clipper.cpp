@@ -9,5 +9,6 @@
 #define CLIPPERLIB_NAMESPACE_PREFIX	Slic3r
 // Override Slic3r::ClipperLib::IntPoint to Slic3r::Point
 #define CLIPPERLIB_INTPOINT_TYPE    Slic3r::Point
+#define CLIPPERLIB_PATH_ALLOCATOR   Slic3r::PointsAllocator
 
 #include <clipper/clipper.cpp>
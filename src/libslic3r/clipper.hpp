@@ -16,11 +16,14 @@
 
 #define CLIPPERLIB_NAMESPACE_PREFIX		Slic3r
 #define CLIPPERLIB_INTPOINT_TYPE    	Slic3r::Point
+// ClipperLib::Path has to be the same type as Slic3r::Points.
+#define CLIPPERLIB_PATH_ALLOCATOR       Slic3r::PointsAllocator
 
 #include <clipper/clipper.hpp>
 
 #undef clipper_hpp
 #undef CLIPPERLIB_NAMESPACE_PREFIX
 #undef CLIPPERLIB_INTPOINT_TYPE
+#undef CLIPPERLIB_PATH_ALLOCATOR
 
 #endif // slic3r_clipper_hpp
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <memory>
 
 #include "miniz_extension.hpp"
 #include "miniz.h"
@@ -77,6 +78,23 @@ bool open_zip_writer(mz_zip_archive *zip, const std::string &fname)
 bool close_zip_reader(mz_zip_archive *zip) { return close_zip(zip, true); }
 bool close_zip_writer(mz_zip_archive *zip) { return close_zip(zip, false); }
 
+bool deflate_chunk(const char *data, size_t size, MZ_DeflatedChunk &out, int level)
+{
+    out.data.clear();
+    out.data.reserve(size / 4);
+    out.uncomp_crc32 = mz_uint32(mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(data), size));
+    out.uncomp_size  = size;
+
+    auto compressor = std::make_unique<tdefl_compressor>();
+    auto put_buf    = [](const void *buf, int len, void *user) -> mz_bool {
+        static_cast<std::string*>(user)->append(static_cast<const char*>(buf), size_t(len));
+        return MZ_TRUE;
+    };
+    return tdefl_init(compressor.get(), put_buf, &out.data, tdefl_create_comp_flags_from_zip_params(level, -15, MZ_DEFAULT_STRATEGY)) == TDEFL_STATUS_OKAY &&
+           // Sync flush aligns the end of the chunk to a byte boundary without terminating the deflate stream.
+           tdefl_compress_buffer(compressor.get(), data, size, TDEFL_SYNC_FLUSH) == TDEFL_STATUS_OKAY;
+}
+
 MZ_Archive::MZ_Archive()
 {
     mz_zip_zero_struct(&arch);
@@ -11,6 +11,17 @@ bool open_zip_writer(mz_zip_archive *zip, const std::string &fname_utf8);
 bool close_zip_reader(mz_zip_archive *zip);
 bool close_zip_writer(mz_zip_archive *zip);
 
+// Part of a file compressed independently of the rest of the file, to be appended
+// by mz_zip_writer_add_staged_compressed_data(). Used to compress large files in parallel.
+struct MZ_DeflatedChunk
+{
+    std::string data;
+    mz_uint32   uncomp_crc32 { MZ_CRC32_INIT };
+    size_t      uncomp_size  { 0 };
+};
+
+bool deflate_chunk(const char *data, size_t size, MZ_DeflatedChunk &out, int level = MZ_DEFAULT_LEVEL);
+
 class MZ_Archive {
 public:
     mz_zip_archive arch;
@@ -179,6 +179,9 @@ void BackgroundSlicingProcess::process_fff()
 		// Passing the timestamp 
 		evt.SetInt((int)(m_fff_print->step_state_with_timestamp(PrintStep::psSlicingFinished).timestamp));
 		wxQueueEvent(GUI::wxGetApp().mainframe->m_plater, evt.Clone());
+		if (m_gcode_result != nullptr)
+			// Let the next export replay the time estimator's planner, as long as the G-code did not change.
+			m_gcode_result->planner_checkpoints.enabled = true;
 		m_fff_print->export_gcode(m_temp_output_path, m_gcode_result, [this](const ThumbnailsParams& params) { return this->render_thumbnails(params); });
 	}
 
@@ -188,11 +188,14 @@ GCodeInputData convert(const Slic3r::GCodeProcessorResult& result, const std::ve
         ret.color_print_colors.emplace_back(convert(color));
     }
 
-    const std::vector<Slic3r::GCodeProcessorResult::MoveVertex>& moves = result.moves;
+    const Slic3r::GCodeProcessorResult::Moves& moves = result.moves;
     ret.vertices.reserve(2 * moves.size());
+    // the moves are materialized one at a time from the columnar storage, the previous one is kept for the next iteration
+    Slic3r::GCodeProcessorResult::MoveVertex prev;
+    Slic3r::GCodeProcessorResult::MoveVertex curr = moves.empty() ? Slic3r::GCodeProcessorResult::MoveVertex() : moves[0];
     for (size_t i = 1; i < moves.size(); ++i) {
-        const Slic3r::GCodeProcessorResult::MoveVertex& curr = moves[i];
-        const Slic3r::GCodeProcessorResult::MoveVertex& prev = moves[i - 1];
+        prev = curr;
+        curr = moves[i];
         const EMoveType curr_type = convert(curr.type);
         const EOptionType option_type = move_type_to_option(curr_type);
         if (option_type == EOptionType::COUNT || option_type == EOptionType::Travels || option_type == EOptionType::Wipes) {
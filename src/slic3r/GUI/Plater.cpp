@@ -11,6 +11,7 @@
 #include <string>
 #include <regex>
 #include <future>
+#include <atomic>
 #include <utility>
 #include <boost/algorithm/string.hpp>
 #include <boost/nowide/cstdio.hpp>
@@ -1276,10 +1277,10 @@ std::vector<size_t> Plater::priv::load_files(const std::vector<fs::path>& input_
     // appear at all. Therefore, we create the dialog on stack on Win and macOS, and on heap on Linux, which
     // is the only system that needed the workarounds in the first place.
 #ifdef __linux__
-    auto progress_dlg = new wxProgressDialog(loading, "", 100, find_toplevel_parent(q), wxPD_APP_MODAL | wxPD_AUTO_HIDE);
+    auto progress_dlg = new wxProgressDialog(loading, "", 100, find_toplevel_parent(q), wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT);
     Slic3r::ScopeGuard([&progress_dlg](){ if (progress_dlg) progress_dlg->Destroy(); progress_dlg = nullptr; });
 #else
-    wxProgressDialog progress_dlg_stack(loading, "", 100, find_toplevel_parent(q), wxPD_APP_MODAL | wxPD_AUTO_HIDE);
+    wxProgressDialog progress_dlg_stack(loading, "", 100, find_toplevel_parent(q), wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT);
     wxProgressDialog* progress_dlg = &progress_dlg_stack;    
 #endif
 
@@ -1330,7 +1331,9 @@ std::vector<size_t> Plater::priv::load_files(const std::vector<fs::path>& input_
         }
 
         if (progress_dlg) {
-            progress_dlg->Update(static_cast<int>(100.0f * static_cast<float>(i) / static_cast<float>(input_files.size())), _L("Loading file") + ": " + from_path(filename));
+            // Only the import of a large STL file may be canceled, see load_progress_fn.
+            if (! progress_dlg->Update(static_cast<int>(100.0f * static_cast<float>(i) / static_cast<float>(input_files.size())), _L("Loading file") + ": " + from_path(filename)))
+                progress_dlg->Resume();
             progress_dlg->Fit();
         }
 
@@ -1371,6 +1374,19 @@ std::vector<size_t> Plater::priv::load_files(const std::vector<fs::path>& input_
 
         FileReader::LoadStats load_stats;
 
+        // Progress of a large STL file being imported, the import may be canceled from the progress dialog.
+        // The cancellation is checked by the worker threads of the import, while the progress dialog is updated from this thread only.
+        std::atomic<bool> load_canceled { false };
+        auto load_progress_fn = [progress_dlg, i, input_files_size, &filename, &load_canceled](int percent) {
+            if (progress_dlg && ! progress_dlg->Update(static_cast<int>((100.0f * static_cast<float>(i) + static_cast<float>(percent)) / static_cast<float>(input_files_size)),
+                                                       _L("Loading file") + ": " + from_path(filename)))
+                load_canceled = true;
+        };
+        auto load_throw_on_cancel_fn = [&load_canceled]() {
+            if (load_canceled)
+                throw CanceledException();
+        };
+
         try {
             if (load_config) {
                 model = FileReader::load_model_with_config(path.string(), &config_loaded, &config_substitutions, qidislicer_generator_version, FileReader::LoadAttribute::CheckVersion, &load_stats);
@@ -1383,8 +1399,13 @@ std::vector<size_t> Plater::priv::load_files(const std::vector<fs::path>& input_
                                                    std::make_pair(linear_precision, angle_precision));
                 }
                 else
-                    model = FileReader::load_model(path.string(), FileReader::LoadAttributes{}, &load_stats);
+                    model = FileReader::load_model(path.string(), FileReader::LoadAttributes{}, &load_stats, std::nullopt, load_progress_fn, load_throw_on_cancel_fn);
             }
+        } catch (const CanceledException &) {
+            // Loading of this file was canceled by the user, continue with the next file.
+            if (progress_dlg)
+                progress_dlg->Resume();
+            continue;
         } catch (const ConfigurationError &e) {
             std::string message = GUI::format(_L("Failed loading file \"%1%\" due to an invalid configuration."), filename.string()) + "\n\n" + e.what();
             GUI::show_error(q, message);
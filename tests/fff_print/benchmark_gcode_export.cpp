@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <oneapi/tbb/global_control.h>
+
+#include <string>
+
+#include "libslic3r/GCode/GCodeWriter.hpp"
+#include "libslic3r/Layer.hpp"
+#include "test_data.hpp"
+
+using namespace Slic3r;
+
+TEST_CASE("G-code export scaling benchmarks", "[GCode][.Benchmarks]") {
+    // Many small layers with arc fitting enabled, so that the smooth path interpolation is a significant part of the export.
+    Print print;
+    Model model;
+    Test::init_print({ Test::TestMesh::sphere_50mm, Test::TestMesh::gt2_teeth, Test::TestMesh::ipadstand }, print, model, {
+        { "layer_height",   0.1 },
+        { "arc_fitting",    "emit_center" },
+        { "perimeters",     3 },
+        { "fill_density",   "20%" },
+        { "support_material", 1 }
+    }, false, 4);
+    print.set_status_silent();
+    print.process();
+
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    for (size_t num_threads : { 1, 8, 16, 32 }) {
+        tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, num_threads);
+        BENCHMARK("export_gcode " + std::to_string(num_threads) + " threads") {
+            return print.export_gcode(path, nullptr, nullptr);
+        };
+    }
+    boost::nowide::remove(path.c_str());
+}
+
+TEST_CASE("G-code formatter benchmarks", "[GCode][.Benchmarks]") {
+    Print print;
+    Model model;
+    Test::init_print({ Test::TestMesh::gt2_teeth }, print, model, {
+        { "layer_height",   0.2 },
+        { "perimeters",     3 },
+        { "fill_density",   "20%" }
+    });
+    print.set_status_silent();
+    print.process();
+
+    // Extrusion moves of a real layer, in millimeters.
+    const PrintObject &object = *print.objects().front();
+    const Layer       &layer  = *object.get_layer(int(object.layer_count() / 2));
+    Points points;
+    for (const LayerRegion *layerm : layer.regions()) {
+        layerm->perimeters().collect_points(points);
+        layerm->fills().collect_points(points);
+    }
+    std::vector<Vec2d> moves;
+    moves.reserve(points.size());
+    for (const Point &pt : points)
+        moves.emplace_back(unscale(pt));
+    REQUIRE(! moves.empty());
+
+    BENCHMARK("GCodeG1Formatter specialized digits") {
+        size_t len = 0;
+        double e   = 0.;
+        for (const Vec2d &pt : moves) {
+            GCodeG1Formatter w;
+            w.emit_xy(pt);
+            w.emit_e("E", e += 0.0123456);
+            len += w.string().size();
+        }
+        return len;
+    };
+    BENCHMARK("GCodeG1Formatter runtime digits") {
+        size_t len = 0;
+        double e   = 0.;
+        for (const Vec2d &pt : moves) {
+            GCodeG1Formatter w;
+            w.emit_axis('X', pt.x(), GCodeFormatter::XYZF_EXPORT_DIGITS);
+            w.emit_axis('Y', pt.y(), GCodeFormatter::XYZF_EXPORT_DIGITS);
+            w.emit_axis('E', e += 0.0123456, GCodeFormatter::E_EXPORT_DIGITS);
+            len += w.string().size();
+        }
+        return len;
+    };
+}
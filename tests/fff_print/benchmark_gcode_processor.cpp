@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include <string>
+
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+#include "libslic3r/GCodeReader.hpp"
+#include "test_data.hpp"
+
+using namespace Slic3r;
+
+static std::string export_large_gcode(bool binary)
+{
+    Print print;
+    Model model;
+    Test::init_print({ Test::TestMesh::sphere_50mm, Test::TestMesh::gt2_teeth, Test::TestMesh::ipadstand }, print, model, {
+        { "layer_height",   0.05 },
+        { "perimeters",     3 },
+        { "fill_density",   "40%" },
+        { "binary_gcode",   binary }
+    }, false, 4);
+    print.set_status_silent();
+    print.process();
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    print.export_gcode(path, nullptr, nullptr);
+    return path;
+}
+
+TEST_CASE("G-code loading benchmarks", "[GCode][.Benchmarks]") {
+    const std::string ascii_path = export_large_gcode(false);
+    const std::string binary_path = export_large_gcode(true);
+
+    BENCHMARK("GCodeReader::parse_file ascii") {
+        GCodeReader reader;
+        std::vector<std::vector<size_t>> lines_ends;
+        size_t num_lines = 0;
+        reader.parse_file(ascii_path, [&num_lines](GCodeReader&, const GCodeReader::GCodeLine&) { ++ num_lines; }, lines_ends);
+        return num_lines;
+    };
+    BENCHMARK("GCodeReader::parse_file_parallel ascii") {
+        GCodeReader reader;
+        std::vector<std::vector<size_t>> lines_ends;
+        size_t num_lines = 0;
+        reader.parse_file_parallel(ascii_path, [&num_lines](GCodeReader&, const GCodeReader::GCodeLine&) { ++ num_lines; }, lines_ends);
+        return num_lines;
+    };
+    BENCHMARK("GCodeProcessor::process_file ascii") {
+        GCodeProcessor processor;
+        processor.process_file(ascii_path);
+        return processor.get_result().moves.size();
+    };
+    BENCHMARK("GCodeProcessor::process_file binary") {
+        GCodeProcessor processor;
+        processor.process_file(binary_path);
+        return processor.get_result().moves.size();
+    };
+
+    boost::nowide::remove(ascii_path.c_str());
+    boost::nowide::remove(binary_path.c_str());
+}
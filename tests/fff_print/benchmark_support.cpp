@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <oneapi/tbb/global_control.h>
+
+#include <iostream>
+#include <string>
+
+#include "libslic3r/SupportSpotsGenerator.hpp"
+#include "libslic3r/Support/TreeModelVolumes.hpp"
+#include "libslic3r/Support/TreeSupport.hpp"
+#include "test_data.hpp"
+
+using namespace Slic3r;
+
+TEST_CASE("Organic tree support scaling benchmarks", "[Support][.Benchmarks]") {
+    Print print;
+    Model model;
+    Test::init_print({ Test::TestMesh::overhang }, print, model, {
+        { "layer_height",           0.1 },
+        { "support_material",       1 },
+        { "support_material_style", "organic" }
+    });
+    print.set_status_silent();
+    print.process();
+    PrintObject &object = *print.get_object(0);
+    REQUIRE(object.support_layer_count() > 0);
+
+    for (size_t num_threads : { 1, 8, 16, 32 }) {
+        tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, num_threads);
+        FFFTreeSupport::TreeModelVolumes::reset_cache_insert_lock_wait();
+        BENCHMARK("fff_tree_support_generate " + std::to_string(num_threads) + " threads") {
+            object.clear_support_layers();
+            fff_tree_support_generate(object);
+            return object.support_layer_count();
+        };
+        std::cout << num_threads << " threads: waited " << FFFTreeSupport::TreeModelVolumes::cache_insert_lock_wait_seconds() <<
+            " s for the RadiusLayerPolygonCache insertion locks" << std::endl;
+    }
+}
+
+TEST_CASE("Organic support collision mode benchmarks", "[Support][.Benchmarks]") {
+    for (const char *mode : { "polygons", "distance_field" }) {
+        Print print;
+        Model model;
+        Test::init_print({ Test::TestMesh::overhang }, print, model, {
+            { "layer_height",                   0.1 },
+            { "support_material",               1 },
+            { "support_material_style",         "organic" },
+            { "support_tree_collision_mode",    mode }
+        });
+        print.set_status_silent();
+        print.process();
+        PrintObject &object = *print.get_object(0);
+        REQUIRE(object.support_layer_count() > 0);
+
+        // The collisions and avoidances are kept between the runs, thus the runs are dominated by the branch placement and smoothing.
+        BENCHMARK(std::string("fff_tree_support_generate ") + mode) {
+            object.clear_support_layers();
+            fff_tree_support_generate(object);
+            return object.support_layer_count();
+        };
+    }
+}
+
+TEST_CASE("Support spots search scaling benchmarks", "[Support][.Benchmarks]") {
+    // Exposes the cancellation callback passed to the search.
+    struct SupportSpotsPrint : Print { using Print::make_try_cancel; };
+    // Tall object with many layers, so that the serial propagation of the object parts is a significant part of the search.
+    SupportSpotsPrint print;
+    Model model;
+    Test::init_print({ Test::TestMesh::sphere_50mm }, print, model, {
+        { "layer_height",   0.1 },
+        { "perimeters",     3 },
+        { "fill_density",   "20%" }
+    });
+    print.set_status_silent();
+    print.process();
+    const PrintObject &object = *print.objects().front();
+    const SupportSpotsGenerator::Params params{ print.config().filament_type.values, float(print.config().perimeter_acceleration.getFloat()),
+        object.config().raft_layers.getInt(), object.config().brim_type.value, float(object.config().brim_width.getFloat()) };
+
+    for (size_t num_threads : { 1, 8, 16, 32 }) {
+        tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, num_threads);
+        BENCHMARK("SupportSpotsGenerator::full_search " + std::to_string(num_threads) + " threads") {
+            return std::get<0>(SupportSpotsGenerator::full_search(&object, print.make_try_cancel(), params)).size();
+        };
+    }
+}
@@ -5,6 +5,11 @@
 #include <regex>
 #include <fstream>
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <boost/nowide/fstream.hpp>
+
 #include "libslic3r/GCode.hpp"
 #include "libslic3r/Geometry/ConvexHull.hpp"
 #include "test_data.hpp"
@@ -341,3 +346,244 @@ TEST_CASE("M201 for acceleation reset", "[GCode]") {
     INFO("M204 is not generated for repetier firmware");
     CHECK(!has_m204);
 }
+
+TEST_CASE("Replayed planner checkpoints", "[GCode]") {
+    auto export_gcode = [](Print &print, GCodeProcessorResult &result) {
+        const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+        print.export_gcode(path, &result, nullptr);
+        boost::nowide::remove(path.c_str());
+    };
+    auto move_times = [](const GCodeProcessorResult &result) {
+        std::vector<GCodeProcessorResult::Moves::Times> out;
+        for (size_t i = 0; i < result.moves.size(); ++ i)
+            out.emplace_back(result.moves.time(i));
+        return out;
+    };
+    auto init = [](Print &print, Model &model, double top_solid_infill_speed) {
+        Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+            { "gcode_flavor",           "marlin2" },
+            { "silent_mode",            1 },
+            { "top_solid_infill_speed", top_solid_infill_speed }
+        });
+        print.process();
+    };
+
+    Print print;
+    Model model;
+    init(print, model, 40.);
+    GCodeProcessorResult reference;
+    export_gcode(print, reference);
+    CHECK(reference.planner_checkpoints.machines.front().empty());
+
+    GCodeProcessorResult result;
+    result.planner_checkpoints.enabled = true;
+    export_gcode(print, result);
+    for (const std::vector<GCodeProcessorResult::PlannerCheckpoint> &checkpoints : result.planner_checkpoints.machines)
+        REQUIRE(checkpoints.size() > 1);
+    // Nothing to replay on the first export.
+    CHECK(result.planner_checkpoints.num_replayed == 0);
+
+    SECTION("Exporting the same print again replays all checkpoints") {
+        const size_t num_checkpoints = result.planner_checkpoints.machines.front().size();
+        const size_t num_checkpoints_all = num_checkpoints + result.planner_checkpoints.machines.back().size();
+        export_gcode(print, result);
+        CHECK(result.planner_checkpoints.machines.front().size() == num_checkpoints);
+        REQUIRE(result.planner_checkpoints.num_replayed > 0);
+        CHECK(result.planner_checkpoints.num_replayed == num_checkpoints_all);
+        CHECK(result.print_statistics.modes[0].time == reference.print_statistics.modes[0].time);
+        CHECK(result.print_statistics.modes[1].time == reference.print_statistics.modes[1].time);
+        CHECK(move_times(result) == move_times(reference));
+    }
+    SECTION("Exporting a print changed at the top layers replays the checkpoints up to the change") {
+        Print print2;
+        Model model2;
+        init(print2, model2, 20.);
+        GCodeProcessorResult reference2;
+        export_gcode(print2, reference2);
+        REQUIRE(reference2.print_statistics.modes[0].time > reference.print_statistics.modes[0].time);
+        // Replay the checkpoints of the first print.
+        const size_t num_checkpoints_all = result.planner_checkpoints.machines.front().size() + result.planner_checkpoints.machines.back().size();
+        export_gcode(print2, result);
+        REQUIRE(result.planner_checkpoints.num_replayed > 0);
+        CHECK(result.planner_checkpoints.num_replayed < num_checkpoints_all);
+        CHECK(result.print_statistics.modes[0].time == reference2.print_statistics.modes[0].time);
+        CHECK(result.print_statistics.modes[1].time == reference2.print_statistics.modes[1].time);
+        CHECK(move_times(result) == move_times(reference2));
+    }
+}
+
+TEST_CASE("Memory of the processed moves", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::sphere_50mm}, print, model, {
+        { "layer_height",   0.2 },
+        { "perimeters",     3 },
+        { "fill_density",   "20%" }
+    });
+    print.process();
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    GCodeProcessorResult result;
+    print.export_gcode(path, &result, nullptr);
+    boost::nowide::remove(path.c_str());
+
+    // The width and mm3_per_mm of the extrusions differ from move to move, the other attributes are shared by many moves.
+    REQUIRE(result.moves.size() > 10000);
+    CHECK(result.moves.attributes_count() < result.moves.size() / 10);
+    CHECK(result.moves.memsize() < result.moves.size() * sizeof(GCodeProcessorResult::MoveVertex) * 3 / 4);
+}
+
+TEST_CASE("Print time per layer", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 }
+    });
+    print.process();
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    GCodeProcessorResult result;
+    print.export_gcode(path, &result, nullptr);
+    boost::nowide::remove(path.c_str());
+
+    const PrintEstimatedStatistics::Mode &normal = result.print_statistics.modes[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal)];
+    CHECK(normal.layers_times.size() == print.objects().front()->layer_count());
+    double sum = 0.;
+    for (float layer_time : normal.layers_times) {
+        CHECK(layer_time > 0.f);
+        sum += layer_time;
+    }
+    CHECK(sum == Approx(normal.time).epsilon(0.01));
+}
+
+TEST_CASE("Statistics only G-code processing", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 }
+    });
+    print.process();
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    print.export_gcode(path, nullptr, nullptr);
+
+    GCodeProcessor full;
+    full.process_file(path);
+    GCodeProcessor statistics_only;
+    statistics_only.enable_statistics_only(true);
+    statistics_only.process_file(path);
+    boost::nowide::remove(path.c_str());
+
+    const GCodeProcessorResult &full_result  = full.get_result();
+    const GCodeProcessorResult &stats_result = statistics_only.get_result();
+    CHECK(full_result.moves.size() > 1);
+    CHECK(stats_result.moves.size() == 0);
+    CHECK(stats_result.lines_ends.empty());
+    for (size_t i = 0; i < static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count); ++i) {
+        const PrintEstimatedStatistics::Mode &full_mode  = full_result.print_statistics.modes[i];
+        const PrintEstimatedStatistics::Mode &stats_mode = stats_result.print_statistics.modes[i];
+        CHECK(stats_mode.time == Approx(full_mode.time));
+        CHECK(stats_mode.layers_times.size() == full_mode.layers_times.size());
+    }
+    CHECK(stats_result.print_statistics.volumes_per_extruder == full_result.print_statistics.volumes_per_extruder);
+    CHECK(stats_result.print_statistics.used_filaments_per_role.size() == full_result.print_statistics.used_filaments_per_role.size());
+}
+
+TEST_CASE("Binary G-code export", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 },
+        { "binary_gcode",       1 }
+    });
+    print.process();
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.bgcode")).string();
+    GCodeProcessorResult exported;
+    print.export_gcode(path, &exported, nullptr);
+
+    // All the G-code blocks have to be written in order for the file to be read back.
+    GCodeProcessor processor;
+    processor.process_file(path);
+    boost::nowide::remove(path.c_str());
+    const GCodeProcessorResult &loaded = processor.get_result();
+    CHECK(loaded.is_binary_file);
+    CHECK(loaded.moves.size() == exported.moves.size());
+    const size_t normal = static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal);
+    CHECK(loaded.print_statistics.modes[normal].time == Approx(exported.print_statistics.modes[normal].time));
+}
+
+// Read an exported G-code without its header line, which contains the time of the export.
+static std::string read_exported_gcode(const std::string &path)
+{
+    boost::nowide::ifstream ifs(path, std::ios::binary);
+    std::string gcode((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    if (boost::starts_with(gcode, "; generated by "))
+        gcode.erase(0, gcode.find('\n') + 1);
+    return gcode;
+}
+
+TEST_CASE("G-code export post processes the raw G-code into the destination", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+        { "gcode_flavor",       "marlin2" },
+        { "remaining_times",    1 },
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 }
+    });
+    print.process();
+    const boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    const std::string path = (dir / "exported.gcode").string();
+    print.export_gcode(path, nullptr, nullptr);
+    const std::string gcode = read_exported_gcode(path);
+
+    SECTION("The destination is written with the remaining times and statistics filled in") {
+        REQUIRE(! gcode.empty());
+        CHECK(gcode.find("\nM73 P0 R") != std::string::npos);
+        CHECK(gcode.find("\nM73 P100 R0\n") != std::string::npos);
+        CHECK(gcode.find("; estimated printing time (normal mode) = ") != std::string::npos);
+        CHECK(gcode.find(PrintStatistics::FilamentUsedMmMask) != std::string::npos);
+        for (GCodeProcessor::ETags tag : { GCodeProcessor::ETags::First_Line_M73_Placeholder, GCodeProcessor::ETags::Last_Line_M73_Placeholder,
+                                           GCodeProcessor::ETags::Estimated_Printing_Time_Placeholder })
+            CHECK(gcode.find(GCodeProcessor::reserved_tag(tag)) == std::string::npos);
+        // The temporary files are removed.
+        CHECK(std::distance(boost::filesystem::directory_iterator(dir), boost::filesystem::directory_iterator()) == 1);
+    }
+    SECTION("Generating the raw G-code next to the destination produces the same G-code") {
+        const std::string path_in_place = (dir / "exported_in_place.gcode").string();
+        GCodeGenerator gcodegen(&print);
+        REQUIRE(gcodegen.do_export(&print, path_in_place.c_str(), nullptr, nullptr, false));
+        CHECK(read_exported_gcode(path_in_place) == gcode);
+        CHECK(std::distance(boost::filesystem::directory_iterator(dir), boost::filesystem::directory_iterator()) == 2);
+    }
+
+    boost::filesystem::remove_all(dir);
+}
+
+TEST_CASE("G-code with failed custom G-code templates is kept next to the destination", "[GCode]") {
+    Print print;
+    Model model;
+    Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+        { "start_gcode", "{undefined_custom_gcode_variable}" }
+    });
+    print.process();
+    const boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    const std::string path = (dir / "exported.gcode").string();
+
+    std::string message;
+    try {
+        print.export_gcode(path, nullptr, nullptr);
+    } catch (const PlaceholderParserError &ex) {
+        message = ex.what();
+    }
+    REQUIRE(! message.empty());
+    CHECK(message.find(path + ".tmp") != std::string::npos);
+    CHECK(! boost::filesystem::exists(path));
+    REQUIRE(boost::filesystem::exists(path + ".tmp"));
+    const std::string gcode = read_exported_gcode(path + ".tmp");
+    CHECK(gcode.find("!!!!! Failed to process the custom G-code template start_gcode") != std::string::npos);
+
+    boost::filesystem::remove_all(dir);
+}
@@ -536,4 +536,38 @@ TEST_CASE("GCodeWriter emits G1 code correctly according to XYZF_EXPORT_DIGITS",
         std::string result3{ writer.travel_to_xyz(v3) };
         CHECK(result3 == "");
     }
-}
\ No newline at end of file
+}
+TEST_CASE("GCodeFormatter emits fixed point numbers", "[GCodeWriter]") {
+    auto format = [](double v, size_t digits) {
+        GCodeG1Formatter formatter;
+        formatter.emit_axis('X', v, digits);
+        return formatter.string();
+    };
+    CHECK(format(0., 3) == "G1 X0\n");
+    CHECK(format(-0., 3) == "G1 X0\n");
+    CHECK(format(-0.0004, 3) == "G1 X0\n");
+    CHECK(format(0.5, 3) == "G1 X.5\n");
+    CHECK(format(-0.5, 3) == "G1 X-.5\n");
+    CHECK(format(0.0005, 3) == "G1 X.001\n");
+    CHECK(format(12.3456, 3) == "G1 X12.346\n");
+    CHECK(format(-12.3, 3) == "G1 X-12.3\n");
+    CHECK(format(100., 3) == "G1 X100\n");
+    CHECK(format(-1000000., 3) == "G1 X-1000000\n");
+    CHECK(format(99999.123, 3) == "G1 X99999.123\n");
+    CHECK(format(0.00001, 5) == "G1 X.00001\n");
+    CHECK(format(1.23456789, 5) == "G1 X1.23457\n");
+    CHECK(format(7.6, 0) == "G1 X8\n");
+    CHECK(format(-0.123456789, 9) == "G1 X-.123456789\n");
+
+    SECTION("Specialized emitters match the runtime dispatch") {
+        for (double v : { 0., 0.0015, -0.0015, 1.25, -1.25, 123.4565, -123.4565, 0.00499, 250.0001 }) {
+            GCodeG1Formatter specialized;
+            specialized.emit_axis<GCodeFormatter::XYZF_EXPORT_DIGITS>('X', v);
+            specialized.emit_axis<GCodeFormatter::E_EXPORT_DIGITS>('E', v);
+            GCodeG1Formatter runtime;
+            runtime.emit_axis('X', v, GCodeFormatter::XYZF_EXPORT_DIGITS);
+            runtime.emit_axis('E', v, GCodeFormatter::E_EXPORT_DIGITS);
+            CHECK(specialized.string() == runtime.string());
+        }
+    }
+}
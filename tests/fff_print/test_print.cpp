@@ -90,6 +90,137 @@ SCENARIO("Print: Changing number of solid surfaces does not cause all surfaces t
     }
 }
 
+SCENARIO("Print: Changing a layer range config regenerates only the layers around the layer range.", "[Print]") {
+    GIVEN("20mm cube with a layer range modifier from 5mm to 10mm") {
+        auto config = Slic3r::DynamicPrintConfig::full_print_config_with({
+            { "layer_height",                   0.25 },
+            { "first_layer_height",             0.25 },
+            { "top_solid_layers",               3 },
+            { "bottom_solid_layers",            3 },
+            { "top_solid_min_thickness",        0 },
+            { "bottom_solid_min_thickness",     0 },
+            { "fill_pattern",                   "rectilinear" },
+            { "enable_dynamic_overhang_speeds", false },
+            { "enable_dynamic_fan_speeds",      "0" },
+            { "avoid_crossing_curled_overhangs", false },
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ TestMesh::cube_20x20x20 }, print, model, config);
+        model.objects.front()->layer_config_ranges[{ 5., 10. }].set("perimeters", 2);
+        print.apply(model, config);
+        print.process();
+
+        // Summary of the extrusions of each layer.
+        auto layer_extrusions = [](const Print &print) {
+            std::vector<std::pair<double, double>> out;
+            for (const Layer *layer : print.objects().front()->layers()) {
+                double perimeters = 0., fills = 0.;
+                for (const LayerRegion *layerm : layer->regions()) {
+                    perimeters += layerm->perimeters().length();
+                    fills      += layerm->fills().length();
+                }
+                out.emplace_back(perimeters, fills);
+            }
+            return out;
+        };
+        auto first_perimeter = [&print](size_t layer_id) -> const ExtrusionEntity* {
+            for (const LayerRegion *layerm : print.objects().front()->get_layer(int(layer_id))->regions())
+                if (! layerm->perimeters().empty())
+                    return layerm->perimeters().entities.front();
+            return nullptr;
+        };
+        const ExtrusionEntity *perimeter_below = first_perimeter(2);
+        const ExtrusionEntity *perimeter_above = first_perimeter(70);
+        const std::vector<std::pair<double, double>> extrusions_before = layer_extrusions(print);
+        REQUIRE(perimeter_below != nullptr);
+        REQUIRE(perimeter_above != nullptr);
+
+        WHEN("number of perimeters of the layer range is changed") {
+            model.objects.front()->layer_config_ranges[{ 5., 10. }].set("perimeters", 4);
+            print.apply(model, config);
+            print.process();
+            const std::vector<std::pair<double, double>> extrusions = layer_extrusions(print);
+            THEN("layers far from the layer range are not regenerated") {
+                REQUIRE(first_perimeter(2) == perimeter_below);
+                REQUIRE(first_perimeter(70) == perimeter_above);
+            }
+            THEN("layers of the layer range are regenerated") {
+                REQUIRE(extrusions[30].first > extrusions_before[30].first);
+            }
+            THEN("the result matches slicing from scratch") {
+                Slic3r::Print print_new;
+                print_new.apply(model, config);
+                print_new.process();
+                REQUIRE(layer_extrusions(print_new) == extrusions);
+            }
+        }
+    }
+}
+
+SCENARIO("Print: Editing the layer height profile regenerates only the edited band.", "[Print]") {
+    GIVEN("20mm cube sliced with a constant layer height") {
+        auto config = Slic3r::DynamicPrintConfig::full_print_config_with({
+            { "layer_height",                   0.25 },
+            { "first_layer_height",             0.25 },
+            { "top_solid_layers",               3 },
+            { "bottom_solid_layers",            3 },
+            { "top_solid_min_thickness",        0 },
+            { "bottom_solid_min_thickness",     0 },
+            { "fill_pattern",                   "rectilinear" },
+            { "enable_dynamic_overhang_speeds", false },
+            { "enable_dynamic_fan_speeds",      "0" },
+            { "avoid_crossing_curled_overhangs", false },
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ TestMesh::cube_20x20x20 }, print, model, config);
+        print.process();
+
+        auto layer_extrusions = [](const Print &print) {
+            std::vector<std::tuple<double, double, double>> out;
+            for (const Layer *layer : print.objects().front()->layers()) {
+                double perimeters = 0., fills = 0.;
+                for (const LayerRegion *layerm : layer->regions()) {
+                    perimeters += layerm->perimeters().length();
+                    fills      += layerm->fills().length();
+                }
+                out.emplace_back(layer->print_z, perimeters, fills);
+            }
+            return out;
+        };
+        const PrintObject     *print_object    = print.objects().front();
+        const Layer           *layer_below     = print_object->get_layer(2);
+        const ExtrusionEntity *perimeter_below = layer_below->regions().front()->perimeters().entities.front();
+        const size_t           num_layers      = print_object->layer_count();
+
+        WHEN("the layer height is reduced between 10mm and 12mm") {
+            model.objects.front()->layer_height_profile.set({ 0., 0.25, 10., 0.25, 10., 0.1, 12., 0.1, 12., 0.25, 20., 0.25 });
+            print.apply(model, config);
+            print.process();
+            THEN("the PrintObject is kept") {
+                REQUIRE(print.objects().front() == print_object);
+            }
+            THEN("layers far below the edited band are not regenerated") {
+                REQUIRE(print_object->get_layer(2) == layer_below);
+                REQUIRE(print_object->get_layer(2)->regions().front()->perimeters().entities.front() == perimeter_below);
+            }
+            THEN("the edited band is sliced again") {
+                REQUIRE(print_object->layer_count() > num_layers);
+            }
+            THEN("a single slice cache entry is kept for the volume") {
+                REQUIRE(print_object->shared_regions()->cached_volume_slices.volumes.size() == 1);
+            }
+            THEN("the result matches slicing from scratch") {
+                Slic3r::Print print_new;
+                print_new.apply(model, config);
+                print_new.process();
+                REQUIRE(layer_extrusions(print_new) == layer_extrusions(print));
+            }
+        }
+    }
+}
+
 SCENARIO("Print: Brim generation", "[Print]") {
     GIVEN("20mm cube and default config, 1mm first layer width") {
         WHEN("Brim is set to 3mm")  {
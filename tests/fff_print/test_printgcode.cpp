@@ -7,6 +7,8 @@
 #include "test_data.hpp"
 
 #include <algorithm>
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/cstdio.hpp>
 #include <boost/regex.hpp>
 
 using namespace Slic3r;
@@ -271,3 +273,44 @@ SCENARIO( "PrintGCode basic functionality", "[PrintGCode]") {
         }
     }
 }
+
+TEST_CASE("Parallel G-code parsing matches sequential parsing", "[PrintGCode]") {
+    Slic3r::Print print;
+    Slic3r::Model model;
+    Slic3r::Test::init_print({TestMesh::cube_20x20x20, TestMesh::sphere_50mm}, print, model, {
+        { "layer_height",       0.1 },
+        { "gcode_comments",     true },
+        { "use_relative_e_distances", true }
+    });
+    // Large enough to be split into several chunks.
+    const std::string gcode = Slic3r::Test::gcode(print);
+    REQUIRE(gcode.size() > 2 * 1024 * 1024);
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    {
+        FILE *f = boost::nowide::fopen(path.c_str(), "wb");
+        REQUIRE(f != nullptr);
+        fwrite(gcode.data(), 1, gcode.size(), f);
+        fclose(f);
+    }
+
+    auto parse = [&path, &print](bool parallel, std::vector<std::vector<size_t>> &lines_ends) {
+        std::vector<std::pair<std::string, Vec3f>> out;
+        GCodeReader reader;
+        reader.apply_config(print.config());
+        auto callback = [&out](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+            out.emplace_back(line.raw(), Vec3f(reader.x(), reader.e(), line.new_E(reader)));
+        };
+        if (parallel)
+            reader.parse_file_parallel(path, callback, lines_ends);
+        else
+            reader.parse_file(path, callback, lines_ends);
+        return out;
+    };
+    std::vector<std::vector<size_t>> lines_ends, lines_ends_parallel;
+    const auto lines = parse(false, lines_ends);
+    const auto lines_parallel = parse(true, lines_ends_parallel);
+    boost::nowide::remove(path.c_str());
+
+    CHECK(lines == lines_parallel);
+    CHECK(lines_ends == lines_ends_parallel);
+}
@@ -89,3 +89,23 @@ SCENARIO("PrintObject: object layer heights", "[PrintObject]") {
 #endif
     }
 }
+
+SCENARIO("PrintObject: layer outline index", "[PrintObject]") {
+    GIVEN("A sliced object with holes") {
+        Slic3r::Print print;
+        Slic3r::Test::init_and_process_print({TestMesh::ipadstand}, print, {
+            { "layer_height", 0.2 }
+        });
+        SpanOfConstPtrs<Layer> layers = print.objects().front()->layers();
+        THEN("The outline index of each layer holds all the edges of its lslices") {
+            for (const Layer *layer : layers)
+                REQUIRE(layer->lslices_distancer().get_lines().size() == count_points(layer->lslices));
+        }
+        THEN("Distances to the outline of a layer are measured against its lslices") {
+            const Layer &layer = *layers[layers.size() / 2];
+            REQUIRE(! layer.lslices.empty());
+            const Vec2d pt = unscaled(layer.lslices.front().contour.points.front());
+            REQUIRE(std::abs(layer.lslices_distancer().distance_from_lines<false>(pt)) < EPSILON);
+        }
+    }
+}
@@ -1,12 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Layer.hpp"
+#include "libslic3r/Support/TreeModelVolumes.hpp"
 
 #include "test_data.hpp" // get access to init_print, etc
 
 using namespace Slic3r::Test;
 using namespace Slic3r;
+using namespace Catch;
 
 TEST_CASE("SupportMaterial: Three raft layers created", "[SupportMaterial]")
 {
@@ -237,6 +240,64 @@ SCENARIO("SupportMaterial: Checking bridge speed", "[SupportMaterial]")
 
 #endif
 
+SCENARIO("SupportMaterial: Tree support collisions are reused between support generations", "[SupportMaterial]")
+{
+    GIVEN("Overhang with organic supports") {
+        auto config = Slic3r::DynamicPrintConfig::full_print_config_with({
+            { "layer_height",                        0.2 },
+            { "support_material",                    1 },
+            { "support_material_style",              "organic" },
+            { "support_material_interface_spacing",  0.2 }
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ TestMesh::overhang }, print, model, config);
+        print.process();
+
+        auto support_volume = [](const Print &print) {
+            double volume = 0.;
+            for (const SupportLayer *layer : print.objects().front()->support_layers())
+                volume += layer->support_fills.total_volume();
+            return volume;
+        };
+        PrintObject &object = *print.get_object(0);
+        const FFFTreeSupport::TreeModelVolumes *volumes = object.tree_model_volumes_cache().get();
+        REQUIRE(volumes != nullptr);
+
+        WHEN("support interface spacing is changed") {
+            config.set_deserialize_strict({ { "support_material_interface_spacing", 0.5 } });
+            print.apply(model, config);
+            print.process();
+            THEN("the collisions and avoidances are reused") {
+                REQUIRE(object.tree_model_volumes_cache().get() == volumes);
+            }
+            THEN("the result matches generating supports from scratch") {
+                Slic3r::Print print_new;
+                print_new.apply(model, config);
+                print_new.process();
+                REQUIRE(print_new.objects().front()->support_layer_count() == object.support_layer_count());
+                REQUIRE(support_volume(print_new) == Approx(support_volume(print)));
+            }
+        }
+        WHEN("support XY distance is changed") {
+            config.set_deserialize_strict({ { "support_material_xy_spacing", "100%" } });
+            print.apply(model, config);
+            print.process();
+            THEN("the collisions and avoidances are recalculated") {
+                REQUIRE(object.tree_model_volumes_cache() != nullptr);
+                REQUIRE(object.tree_model_volumes_cache().get() != volumes);
+            }
+        }
+        WHEN("the object is resliced") {
+            config.set_deserialize_strict({ { "layer_height", 0.15 } });
+            print.apply(model, config);
+            THEN("the collisions and avoidances are released") {
+                REQUIRE(object.tree_model_volumes_cache() == nullptr);
+            }
+        }
+    }
+}
+
 
 /* 
 
@@ -0,0 +1,33 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Format/3mf.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+using namespace Slic3r;
+
+TEST_CASE("3MF export and import benchmarks", "[3mf][.Benchmarks]") {
+    // 50 objects, 400k triangles each.
+    Model model;
+    for (int i = 0; i < 50; ++ i) {
+        ModelObject *object = model.add_object();
+        object->add_volume(make_sphere(10., 2. * PI / 632.));
+        object->add_instance()->set_offset(Vec3d(25. * (i % 10), 25. * (i / 10), 10.));
+    }
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.3mf")).string();
+
+    BENCHMARK("store_3mf 50 objects, 20M triangles") {
+        return store_3mf(path.c_str(), &model, nullptr, false);
+    };
+    BENCHMARK("load_3mf 50 objects, 20M triangles") {
+        Model                     loaded;
+        DynamicPrintConfig        config;
+        ConfigSubstitutionContext ctxt{ ForwardCompatibilitySubstitutionRule::Disable };
+        boost::optional<Semver>   version;
+        load_3mf(path.c_str(), config, ctxt, &loaded, false, version);
+        return loaded.objects.size();
+    };
+    boost::filesystem::remove(path);
+}
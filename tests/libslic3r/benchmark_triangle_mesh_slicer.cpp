@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <test_utils.hpp>
+
+#include "libslic3r/TriangleMeshSlicer.hpp"
+
+using namespace Slic3r;
+
+static std::vector<float> slicing_planes(const indexed_triangle_set &its, float layer_height)
+{
+    const BoundingBoxf3 bbox = bounding_box(its);
+    std::vector<float>  zs;
+    for (double z = bbox.min.z() + 0.5 * layer_height; z < bbox.max.z(); z += layer_height)
+        zs.emplace_back(float(z));
+    return zs;
+}
+
+TEST_CASE("Triangle mesh slicer benchmarks", "[TriangleMeshSlicer][.Benchmarks]") {
+    for (const char *obj_filename : { "extruder_idler.obj", "frog_legs.obj", "ipadstand.obj", "sloping_hole.obj" }) {
+        const TriangleMesh mesh = load_model(obj_filename);
+        const std::vector<float> zs = slicing_planes(mesh.its, 0.2f);
+        BENCHMARK(std::string("slice_mesh ") + obj_filename) {
+            return slice_mesh(mesh.its, zs, MeshSlicingParams{});
+        };
+    }
+
+    // Sphere of roughly 5M triangles.
+    const indexed_triangle_set sphere = its_make_sphere(50., 2. * PI / 2240.);
+    const std::vector<float>   zs     = slicing_planes(sphere, 0.2f);
+    BENCHMARK("slice_mesh 5M triangles sphere") {
+        return slice_mesh(sphere, zs, MeshSlicingParams{});
+    };
+    BENCHMARK("slice_mesh_ex 5M triangles sphere") {
+        return slice_mesh_ex(sphere, zs, MeshSlicingParamsEx{});
+    };
+}
@@ -3,6 +3,7 @@
 #include "libslic3r/Model.hpp"
 #include "libslic3r/Format/3mf.hpp"
 #include "libslic3r/Format/STL.hpp"
+#include "libslic3r/TriangleSelector.hpp"
 
 #include <boost/filesystem/operations.hpp>
 
@@ -82,6 +83,52 @@ SCENARIO("Export+Import geometry to/from 3mf file cycle", "[3mf]") {
     }
 }
 
+SCENARIO("Export+Import of a large painted mesh to/from 3mf file cycle", "[3mf]") {
+    GIVEN("sphere of more than 300k triangles with painted seam") {
+        // The mesh is large enough to be formatted, compressed and parsed in multiple chunks in parallel.
+        Model src_model;
+        ModelObject *src_object = src_model.add_object();
+        ModelVolume *src_volume = src_object->add_volume(make_sphere(10., 2. * PI / 560.));
+        src_object->add_instance();
+        {
+            TriangleSelector selector(src_volume->mesh());
+            for (int i = 0; i < int(src_volume->mesh().its.indices.size()); i += 997)
+                selector.set_facet(i, TriangleStateType::ENFORCER);
+            src_volume->seam_facets.set(selector);
+        }
+
+        WHEN("model is saved+loaded to/from 3mf file") {
+            std::string test_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.3mf")).string();
+            REQUIRE(store_3mf(test_file.c_str(), &src_model, nullptr, false));
+
+            Model dst_model;
+            DynamicPrintConfig dst_config;
+            ConfigSubstitutionContext ctxt{ ForwardCompatibilitySubstitutionRule::Disable };
+            boost::optional<Semver> version;
+            bool loaded = load_3mf(test_file.c_str(), dst_config, ctxt, &dst_model, false, version);
+            boost::filesystem::remove(test_file);
+
+            THEN("mesh and painting match") {
+                REQUIRE(loaded);
+                REQUIRE(dst_model.objects.size() == 1);
+                REQUIRE(dst_model.objects.front()->volumes.size() == 1);
+                const ModelVolume          &dst_volume = *dst_model.objects.front()->volumes.front();
+                const indexed_triangle_set &src_its    = src_volume->mesh().its;
+                const indexed_triangle_set &dst_its    = dst_volume.mesh().its;
+                REQUIRE(dst_its.indices == src_its.indices);
+                REQUIRE(dst_its.vertices.size() == src_its.vertices.size());
+                bool vertices_match = true;
+                for (size_t i = 0; i < src_its.vertices.size(); ++ i)
+                    vertices_match &= dst_its.vertices[i].isApprox(src_its.vertices[i]);
+                REQUIRE(vertices_match);
+                REQUIRE(dst_volume.seam_facets.get_data().triangles_to_split.size() == src_volume->seam_facets.get_data().triangles_to_split.size());
+                for (int i = 0; i < int(src_its.indices.size()); i += 997)
+                    REQUIRE(dst_volume.seam_facets.get_triangle_as_string(i) == src_volume->seam_facets.get_triangle_as_string(i));
+            }
+        }
+    }
+}
+
 SCENARIO("2D convex hull of sinking object", "[3mf]") {
     GIVEN("model") {
         // load a model
@@ -5,6 +5,7 @@
 #include <random>
 
 #include <libslic3r/ExtrusionEntity.hpp>
+#include <libslic3r/ExtrusionEntityCollection.hpp>
 #include <libslic3r/GCode/ExtrusionOrder.hpp>
 #include <libslic3r/GCode/SmoothPath.hpp>
 #include <libslic3r/Geometry/ArcWelder.hpp>
@@ -629,3 +630,55 @@ TEST_CASE("arc quantization", "[ArcWelder]") {
     }
 }
 #endif
+
+TEST_CASE("SmoothPathCache interpolates collections in parallel", "[ArcWelder]") {
+    using namespace Slic3r::GCode;
+
+    // Arcs of varying radii sampled into polylines, stored as paths, loops and nested collections.
+    auto arc = [](double radius, double angle, size_t num_points) {
+        Polyline out;
+        for (size_t i = 0; i < num_points; ++ i) {
+            const double a = angle * double(i) / double(num_points - 1);
+            out.points.emplace_back(Vec2d(radius * cos(a), radius * sin(a)).cast<coord_t>());
+        }
+        return out;
+    };
+    const ExtrusionAttributes attributes(ExtrusionRole::ExternalPerimeter, ExtrusionFlow(0.05, 0.45f, 0.2f), false);
+    ExtrusionEntityCollection perimeters;
+    ExtrusionEntityCollection nested;
+    for (size_t i = 0; i < 200; ++ i) {
+        const double radius = scaled<double>(2. + 0.1 * double(i));
+        if (i % 3 == 0)
+            perimeters.append(ExtrusionPath(arc(radius, 0.5 * M_PI, 50 + i), attributes));
+        else if (i % 3 == 1)
+            perimeters.append(ExtrusionLoop(ExtrusionPath(arc(radius, 2. * M_PI, 100), attributes)));
+        else
+            nested.append(ExtrusionPath(arc(radius, M_PI, 30), ExtrusionAttributes(ExtrusionRole::InternalInfill, ExtrusionFlow(0.05, 0.45f, 0.2f), false)));
+    }
+    perimeters.append(std::move(nested));
+
+    const SmoothPathCache::InterpolationParameters params { scaled<double>(0.0125), Geometry::ArcWelder::default_arc_length_percent_tolerance };
+    SmoothPathCache cache;
+    cache.interpolate_add(perimeters, params);
+
+    // Each path has to be interpolated exactly as if fitted one by one.
+    size_t num_paths = 0;
+    auto check = [&cache, &params, &num_paths](const ExtrusionPath &path) {
+        SmoothPathCache serial;
+        serial.interpolate_add(path, params);
+        const Geometry::ArcWelder::Path *fitted = cache.resolve(path);
+        REQUIRE(fitted != nullptr);
+        CHECK(*fitted == *serial.resolve(path));
+        ++ num_paths;
+    };
+    for (const ExtrusionEntity *ee : perimeters)
+        if (const auto *path = dynamic_cast<const ExtrusionPath*>(ee); path)
+            check(*path);
+        else if (const auto *loop = dynamic_cast<const ExtrusionLoop*>(ee); loop)
+            for (const ExtrusionPath &path : loop->paths)
+                check(path);
+        else
+            for (const ExtrusionEntity *ee2 : *static_cast<const ExtrusionEntityCollection*>(ee))
+                check(*static_cast<const ExtrusionPath*>(ee2));
+    CHECK(num_paths == 200);
+}
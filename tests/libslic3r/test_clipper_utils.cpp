@@ -4,6 +4,8 @@
 #include <numeric>
 #include <iostream>
 #include <boost/filesystem.hpp>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 
 #include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/ExPolygon.hpp"
@@ -384,3 +386,90 @@ TEST_CASE("Traversing Clipper PolyTree", "[ClipperUtils]") {
         REQUIRE(count_polys(output) == reference.size());
     }
 }
+
+SCENARIO("ClipperPipeline matches the chained free functions", "[ClipperUtils]") {
+    const auto UNIT = coord_t(1. / SCALING_FACTOR);
+    // A square with a hole and a thin sliver to be removed by the opening.
+    ExPolygons subject {
+        ExPolygon(Polygon{ { 0, 0 }, { 10 * UNIT, 0 }, { 10 * UNIT, 10 * UNIT }, { 0, 10 * UNIT } },
+                  Polygon{ { 3 * UNIT, 3 * UNIT }, { 3 * UNIT, 6 * UNIT }, { 6 * UNIT, 6 * UNIT }, { 6 * UNIT, 3 * UNIT } }),
+        ExPolygon(Polygon{ { 20 * UNIT, 0 }, { 30 * UNIT, 0 }, { 30 * UNIT, UNIT / 10 }, { 20 * UNIT, UNIT / 10 } })
+    };
+    Polygons clip { { { 8 * UNIT, -UNIT }, { 15 * UNIT, -UNIT }, { 15 * UNIT, 4 * UNIT }, { 8 * UNIT, 4 * UNIT } } };
+    const float delta = float(UNIT) / 2.f;
+
+    GIVEN("diff followed by opening") {
+        ExPolygons reference = opening_ex(diff_ex(subject, clip, ApplySafetyOffset::Yes), delta);
+        ExPolygons result    = ClipperPipeline(subject).diff(clip, ApplySafetyOffset::Yes).opening(delta).expolygons();
+        THEN("the results match") {
+            REQUIRE(result.size() == reference.size());
+            REQUIRE(result.size() == 1);
+            REQUIRE(result.front().holes.size() == 1);
+            REQUIRE(area(result) == Approx(area(reference)));
+            REQUIRE(diff_ex(result, reference, ApplySafetyOffset::Yes).empty());
+            REQUIRE(diff_ex(reference, result, ApplySafetyOffset::Yes).empty());
+        }
+    }
+    GIVEN("intersection followed by closing and union") {
+        Polygons subject_polygons = to_polygons(subject);
+        Polygons reference = union_(closing(intersection(subject_polygons, clip), delta), clip);
+        Polygons result    = ClipperPipeline(std::move(subject_polygons)).intersection(clip).closing(delta).union_(clip).polygons();
+        THEN("the results match") {
+            REQUIRE(result.size() == reference.size());
+            REQUIRE(area(result) == Approx(area(reference)));
+        }
+    }
+    GIVEN("overlapping and touching input polygons offsetted first") {
+        // Two touching strips, each thinner than the opening, and two overlapping squares.
+        Polygons input {
+            { { 0, 0 }, { 8 * UNIT / 10, 0 }, { 8 * UNIT / 10, 10 * UNIT }, { 0, 10 * UNIT } },
+            { { 8 * UNIT / 10, 0 }, { 16 * UNIT / 10, 0 }, { 16 * UNIT / 10, 10 * UNIT }, { 8 * UNIT / 10, 10 * UNIT } },
+            { { 5 * UNIT, 0 }, { 15 * UNIT, 0 }, { 15 * UNIT, 10 * UNIT }, { 5 * UNIT, 10 * UNIT } },
+            { { 10 * UNIT, 2 * UNIT }, { 20 * UNIT, 2 * UNIT }, { 20 * UNIT, 12 * UNIT }, { 10 * UNIT, 12 * UNIT } }
+        };
+        const float spacing = float(UNIT) / 2.f;
+        THEN("shrink followed by expand offsets the input polygons one by one, as the free functions do") {
+            Polygons reference = expand(shrink(input, spacing), 4.f * spacing);
+            Polygons result    = ClipperPipeline(input).shrink(spacing).expand(4.f * spacing).polygons();
+            REQUIRE(result.size() == reference.size());
+            REQUIRE(area(result) == Approx(area(reference)));
+            REQUIRE(diff(result, reference, ApplySafetyOffset::Yes).empty());
+            REQUIRE(diff(reference, result, ApplySafetyOffset::Yes).empty());
+            // The strips were removed, only the squares remain.
+            REQUIRE(result.size() == 1);
+        }
+        THEN("closing offsets the input polygons one by one, as the free functions do") {
+            Polygons reference = closing(input, spacing);
+            Polygons result    = ClipperPipeline(input).closing(spacing).polygons();
+            REQUIRE(result.size() == reference.size());
+            REQUIRE(area(result) == Approx(area(reference)));
+        }
+        THEN("an explicit union merges the input polygons before the offset") {
+            Polygons reference = expand(shrink(union_(input), spacing), 4.f * spacing);
+            Polygons result    = ClipperPipeline(input).union_().shrink(spacing).expand(4.f * spacing).polygons();
+            REQUIRE(result.size() == reference.size());
+            REQUIRE(area(result) == Approx(area(reference)));
+            // The merged strips are wide enough to survive the opening.
+            REQUIRE(result.size() == 2);
+        }
+    }
+    GIVEN("an empty pipeline") {
+        THEN("all the operations produce an empty result") {
+            REQUIRE(ClipperPipeline().diff(clip).offset(delta).expolygons().empty());
+            REQUIRE(ClipperPipeline(subject).intersection(Polygons{}).polygons().empty());
+            REQUIRE(ClipperPipeline(subject).shrink(20.f * UNIT).empty());
+        }
+    }
+    GIVEN("pipelines running in parallel") {
+        ExPolygons reference = opening_ex(diff_ex(subject, clip), delta);
+        std::vector<ExPolygons> results(64);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, results.size(), 1), [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                results[i] = ClipperPipeline(subject).diff(clip).opening(delta).expolygons();
+        });
+        THEN("the thread local workspaces do not interfere") {
+            for (const ExPolygons &result : results)
+                REQUIRE(area(result) == Approx(area(reference)));
+        }
+    }
+}
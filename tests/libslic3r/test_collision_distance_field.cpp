@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <random>
+
+#include <libslic3r/Line.hpp>
+#include <libslic3r/Polygon.hpp>
+#include <libslic3r/Support/CollisionDistanceField.hpp>
+
+using namespace Slic3r;
+using namespace Catch;
+
+TEST_CASE("CollisionDistanceField matches the distance to the polygon edges", "[Support]")
+{
+    // Wavy rings, one of them with a hole.
+    Polygons polygons;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> noise(0., 0.5);
+    for (int k = 0; k < 3; ++ k) {
+        Polygon polygon;
+        for (int i = 0; i < 200; ++ i) {
+            double a = 2. * M_PI * i / 200.;
+            double r = 5. + 3. * std::sin(7. * a) + noise(rng);
+            polygon.points.emplace_back(scaled<coord_t>(20. * k + r * std::cos(a)), scaled<coord_t>(r * std::sin(a)));
+        }
+        polygons.emplace_back(std::move(polygon));
+    }
+    polygons.emplace_back(Polygon::new_scale({ { 38., -1. }, { 38., 1. }, { 42., 1. }, { 42., -1. } }));
+
+    std::vector<Linef> lines;
+    for (const Polygon &polygon : polygons)
+        for (const Line &line : polygon.lines())
+            lines.push_back({ unscaled<double>(line.a), unscaled<double>(line.b) });
+
+    const double max_distance = 4.;
+    const double resolution   = 0.25;
+    FFFTreeSupport::CollisionDistanceField field(polygons, max_distance, resolution);
+    REQUIRE(! field.empty());
+
+    std::uniform_real_distribution<double> rx(-15., 55.), ry(-15., 15.), rr(0.5, max_distance);
+    size_t num_hits = 0;
+    for (size_t i = 0; i < 10000; ++ i) {
+        const Vec2d  pt(rx(rng), ry(rng));
+        const double r = rr(rng);
+        double exact = -1.;
+        for (const Linef &line : lines)
+            if (double d2 = line_alg::distance_to_squared(line, pt); d2 < r * r && (exact < 0. || d2 < exact))
+                exact = d2;
+        Vec2d  hit_point;
+        double d2 = field.squared_distance(pt, hit_point, r * r);
+        if (d2 >= 0.) {
+            ++ num_hits;
+            // The returned distance is a distance to a real edge point, at most a cell away from the closest one.
+            REQUIRE(exact >= 0.);
+            REQUIRE(std::sqrt(d2) >= std::sqrt(exact) - EPSILON);
+            REQUIRE(std::sqrt(d2) <= std::sqrt(exact) + resolution);
+            REQUIRE((hit_point - pt).squaredNorm() == Approx(d2));
+        } else if (exact >= 0.)
+            // A collision may only be missed at the very limit of the query radius.
+            REQUIRE(std::sqrt(exact) > r - resolution);
+    }
+    REQUIRE(num_hits > 1000);
+
+    Vec2d hit_point;
+    REQUIRE(field.squared_distance(Vec2d(100., 100.), hit_point, max_distance * max_distance) < 0.);
+    REQUIRE(FFFTreeSupport::CollisionDistanceField(Polygons{}, max_distance, resolution).empty());
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+
+using namespace Slic3r;
+
+using MoveVertex = GCodeProcessorResult::MoveVertex;
+
+// Width and mm3_per_mm vary from move to move, as they are calculated by the processor from the extrusion of each move.
+static MoveVertex make_move(unsigned int gcode_id, EMoveType type, float x, float width)
+{
+    MoveVertex move;
+    move.gcode_id = gcode_id;
+    move.type = type;
+    move.extrusion_role = type == EMoveType::Extrude ? GCodeExtrusionRole::Perimeter : GCodeExtrusionRole::None;
+    move.position = Vec3f(x, 2.f * x, 0.2f);
+    move.delta_extruder = 0.1f * x;
+    move.feedrate = 40.f;
+    move.width = width;
+    move.height = 0.2f;
+    move.mm3_per_mm = 0.05f + 0.001f * x;
+    move.layer_id = 1;
+    return move;
+}
+
+static bool equal(const MoveVertex& lhs, const MoveVertex& rhs)
+{
+    return lhs.gcode_id == rhs.gcode_id && lhs.type == rhs.type && lhs.extrusion_role == rhs.extrusion_role &&
+        lhs.extruder_id == rhs.extruder_id && lhs.cp_color_id == rhs.cp_color_id && lhs.position == rhs.position &&
+        lhs.delta_extruder == rhs.delta_extruder && lhs.feedrate == rhs.feedrate && lhs.actual_feedrate == rhs.actual_feedrate &&
+        lhs.width == rhs.width && lhs.height == rhs.height && lhs.mm3_per_mm == rhs.mm3_per_mm && lhs.fan_speed == rhs.fan_speed &&
+        lhs.temperature == rhs.temperature && lhs.time == rhs.time && lhs.layer_id == rhs.layer_id && lhs.internal_only == rhs.internal_only;
+}
+
+TEST_CASE("GCodeProcessorResult::Moves stores moves column wise", "[GCodeProcessor]")
+{
+    std::vector<MoveVertex> reference;
+    for (unsigned int i = 0; i < 100; ++i)
+        reference.push_back(make_move(i, i % 10 == 0 ? EMoveType::Travel : EMoveType::Extrude, float(i), 0.45f + 0.001f * float(i)));
+
+    GCodeProcessorResult::Moves moves;
+    for (const MoveVertex& move : reference)
+        moves.push_back(move);
+
+    REQUIRE(moves.size() == reference.size());
+    // All the moves share one of the two attribute sets of a travel and of an extrusion.
+    CHECK(moves.attributes_count() == 2);
+
+    SECTION("Moves are materialized unchanged") {
+        size_t i = 0;
+        for (const MoveVertex& move : moves)
+            CHECK(equal(move, reference[i++]));
+        CHECK(i == reference.size());
+    }
+
+    SECTION("Moves are updated in place") {
+        moves.time(5)[0] = 1.5f;
+        moves.actual_feedrate(5) = 30.f;
+        moves.gcode_id(5) = 1000;
+        MoveVertex move = reference[6];
+        move.width = 0.5f;
+        moves.set(6, move);
+        reference[5].time[0] = 1.5f;
+        reference[5].actual_feedrate = 30.f;
+        reference[5].gcode_id = 1000;
+        reference[6] = move;
+        for (size_t i = 0; i < reference.size(); ++i)
+            CHECK(equal(moves[i], reference[i]));
+    }
+
+    SECTION("Moves are resized, copied and erased") {
+        moves.resize(reference.size() + 1);
+        moves.copy(3, reference.size());
+        CHECK(equal(moves.back(), reference[3]));
+        moves.erase(0);
+        reference.erase(reference.begin());
+        REQUIRE(moves.size() == reference.size() + 1);
+        for (size_t i = 0; i < reference.size(); ++i)
+            CHECK(equal(moves[i], reference[i]));
+    }
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
+#include "libslic3r/GCodeReader.hpp"
+
+using namespace Slic3r;
+
+struct ParsedLine
+{
+    std::string raw;
+    bool        has_x;
+    float       x;
+    float       reader_x;
+
+    bool operator==(const ParsedLine &rhs) const { return raw == rhs.raw && has_x == rhs.has_x && x == rhs.x && reader_x == rhs.reader_x; }
+};
+
+struct ParsedGCode
+{
+    bool                             ok { false };
+    std::vector<ParsedLine>          lines;
+    std::vector<std::vector<size_t>> lines_ends;
+};
+
+// Parses the G-code written into a temporary file by the memory mapped reader and by the parallel reader.
+static std::pair<ParsedGCode, ParsedGCode> parse_gcode_file(const std::string &gcode)
+{
+    const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.gcode")).string();
+    {
+        boost::nowide::ofstream file(path, std::ios::binary);
+        file << gcode;
+    }
+    auto parse = [&path](bool parallel) {
+        ParsedGCode out;
+        GCodeReader reader;
+        auto callback = [&out](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+            out.lines.push_back({ line.raw(), line.has(X), line.x(), reader.x() });
+        };
+        out.ok = parallel ? reader.parse_file_parallel(path, callback, out.lines_ends) : reader.parse_file(path, callback, out.lines_ends);
+        return out;
+    };
+    std::pair<ParsedGCode, ParsedGCode> out { parse(false), parse(true) };
+    boost::filesystem::remove(path);
+    return out;
+}
+
+static std::vector<std::string> raw_lines(const ParsedGCode &gcode)
+{
+    std::vector<std::string> out;
+    for (const ParsedLine &line : gcode.lines)
+        out.emplace_back(line.raw);
+    return out;
+}
+
+SCENARIO("GCodeReader splits a file into lines", "[GCodeReader]") {
+    GIVEN("Lines terminated by CR LF") {
+        auto [mapped, parallel] = parse_gcode_file("G1 X1\r\nG1 X2.5\r\n");
+        THEN("The line ends are not part of the lines") {
+            REQUIRE(mapped.ok);
+            CHECK(raw_lines(mapped) == std::vector<std::string>{ "G1 X1", "G1 X2.5" });
+            CHECK(mapped.lines.back().x == 2.5f);
+            CHECK(mapped.lines_ends == std::vector<std::vector<size_t>>{ { 7, 16 } });
+        }
+        THEN("The parallel reader produces the same lines") {
+            REQUIRE(parallel.ok);
+            CHECK(parallel.lines == mapped.lines);
+            CHECK(parallel.lines_ends == mapped.lines_ends);
+        }
+    }
+    GIVEN("The last line not terminated by a newline") {
+        auto [mapped, parallel] = parse_gcode_file("G1 X1\nG1 X2");
+        THEN("The last line is parsed without a line end") {
+            REQUIRE(mapped.ok);
+            CHECK(raw_lines(mapped) == std::vector<std::string>{ "G1 X1", "G1 X2" });
+            CHECK(mapped.lines.back().has_x);
+            CHECK(mapped.lines.back().x == 2.f);
+            CHECK(mapped.lines_ends == std::vector<std::vector<size_t>>{ { 6 } });
+        }
+        THEN("The parallel reader produces the same lines") {
+            REQUIRE(parallel.ok);
+            CHECK(parallel.lines == mapped.lines);
+            CHECK(parallel.lines_ends == mapped.lines_ends);
+        }
+    }
+    GIVEN("Lines and comments longer than eight characters") {
+        // Line ends at all positions relative to the 8 byte words scanned at once.
+        std::string gcode;
+        std::vector<std::string> expected;
+        for (size_t i = 0; i < 24; ++ i) {
+            expected.emplace_back("G1 X" + std::to_string(i) + " ; " + std::string(i, 'c'));
+            expected.emplace_back("; " + std::string(i, 'c'));
+            gcode += expected[expected.size() - 2] + "\n" + expected.back() + (i % 2 ? "\r\n" : "\n");
+        }
+        auto [mapped, parallel] = parse_gcode_file(gcode);
+        THEN("The lines are split at the line ends") {
+            REQUIRE(mapped.ok);
+            CHECK(raw_lines(mapped) == expected);
+            REQUIRE(mapped.lines_ends.front().size() == expected.size());
+            CHECK(mapped.lines_ends.front().back() == gcode.size());
+        }
+        THEN("The axes are parsed up to the comment") {
+            for (size_t i = 0; i < 24; ++ i) {
+                CHECK(mapped.lines[2 * i].x == float(i));
+                CHECK(! mapped.lines[2 * i + 1].has_x);
+                CHECK(mapped.lines[2 * i + 1].reader_x == float(i));
+            }
+        }
+        THEN("The parallel reader produces the same lines") {
+            REQUIRE(parallel.ok);
+            CHECK(parallel.lines == mapped.lines);
+            CHECK(parallel.lines_ends == mapped.lines_ends);
+        }
+    }
+    GIVEN("A file larger than a chunk of the parallel reader") {
+        std::string gcode;
+        for (size_t i = 0; gcode.size() < 3 * 1024 * 1024; ++ i)
+            gcode += "G1 X" + std::to_string(i % 1000) + " Y1.5 E0.0125 ; extrusion\n";
+        gcode += "M107";
+        auto [mapped, parallel] = parse_gcode_file(gcode);
+        THEN("The parallel reader produces the same lines") {
+            REQUIRE(mapped.ok);
+            REQUIRE(parallel.ok);
+            CHECK(mapped.lines.back().raw == "M107");
+            CHECK(parallel.lines.size() == mapped.lines.size());
+            CHECK(parallel.lines == mapped.lines);
+            CHECK(parallel.lines_ends == mapped.lines_ends);
+        }
+    }
+    GIVEN("An empty file") {
+        auto [mapped, parallel] = parse_gcode_file("");
+        THEN("It is read without lines") {
+            REQUIRE(mapped.ok);
+            CHECK(mapped.lines.empty());
+            CHECK(mapped.lines_ends == std::vector<std::vector<size_t>>{ {} });
+            REQUIRE(parallel.ok);
+            CHECK(parallel.lines.empty());
+            CHECK(parallel.lines_ends == mapped.lines_ends);
+        }
+    }
+}
+
+TEST_CASE("GCodeReader parses integer values as strtol() does", "[GCodeReader]") {
+    auto parse_int = [](const std::string &gcode, int &value) {
+        GCodeReader::GCodeLine gline;
+        GCodeReader reader;
+        reader.parse_line(gcode, [&gline](GCodeReader&, const GCodeReader::GCodeLine &line) { gline = line; });
+        return gline.has_value('S', value);
+    };
+    int value = -1;
+    SECTION("Plain number") {
+        CHECK(parse_int("M104 S215", value));
+        CHECK(value == 215);
+    }
+    SECTION("Negative number followed by a comment") {
+        CHECK(parse_int("M104 S-5;comment", value));
+        CHECK(value == -5);
+    }
+    SECTION("Leading plus sign") {
+        CHECK(parse_int("M104 S+42", value));
+        CHECK(value == 42);
+    }
+    SECTION("Whitespaces around the number") {
+        CHECK(parse_int("M104 S 7 T1", value));
+        CHECK(value == 7);
+        CHECK(parse_int("M104 S\t8\t", value));
+        CHECK(value == 8);
+    }
+    SECTION("Empty number is zero") {
+        CHECK(parse_int("M104 S", value));
+        CHECK(value == 0);
+        value = -1;
+        CHECK(parse_int("M104 S T1", value));
+        CHECK(value == 0);
+    }
+    SECTION("Invalid numbers are rejected") {
+        CHECK(! parse_int("M104 S+", value));
+        CHECK(! parse_int("M104 S12abc", value));
+        CHECK(! parse_int("M104 S1.5", value));
+        CHECK(value == -1);
+    }
+    SECTION("Overflow is rejected") {
+        CHECK(! parse_int("M104 S99999999999", value));
+        CHECK(! parse_int("M104 S-99999999999", value));
+        CHECK(value == -1);
+    }
+}
@@ -2,6 +2,8 @@
 
 #include "libslic3r/Point.hpp"
 #include "libslic3r/Polygon.hpp"
+#include "libslic3r/PointsArena.hpp"
+#include "libslic3r/ClipperUtils.hpp"
 
 using namespace Slic3r;
 
@@ -228,3 +230,30 @@ TEST_CASE("Indexing expolygons", "[ExPolygon]")
         CHECK(linesf[i].b.cast<int>() == p_b);
     }
 }
+
+TEST_CASE("Polygons outliving their PointsArenaScope", "[Polygon]")
+{
+    reset_points_allocation_stats();
+    Polygons kept;
+    {
+        PointsArenaScope points_arena;
+        Polygons temporaries;
+        for (int i = 0; i < 1000; ++ i)
+            temporaries.push_back(Polygon{ { 0, 0 }, { 100 + i, 0 }, { 100 + i, 100 }, { 0, 100 } });
+        kept.push_back(temporaries[500]);
+        kept.push_back(std::move(temporaries.back()));
+        append(kept, offset(temporaries.front(), 10.f));
+    }
+    REQUIRE(kept.size() == 3);
+    CHECK(kept[0].area() == 600. * 100.);
+    CHECK(kept[1].area() == 1099. * 100.);
+    CHECK(kept[2].is_counter_clockwise());
+    kept.clear();
+    kept.shrink_to_fit();
+#ifdef SLIC3R_POINTS_ARENA
+    const PointsAllocationStats stats = points_allocation_stats();
+    CHECK(stats.arena_allocations > 1000);
+    CHECK(stats.chunks > 0);
+    CHECK(stats.chunks_alive == 0);
+#endif // SLIC3R_POINTS_ARENA
+}
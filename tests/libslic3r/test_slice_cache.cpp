@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <ctime>
+
+#include "libslic3r/Geometry.hpp"
+#include "libslic3r/SliceCache.hpp"
+#include "libslic3r/TriangleMesh.hpp"
+
+using namespace Slic3r;
+
+TEST_CASE("Slice cache round trip", "[SliceCache]") {
+    boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    set_slice_cache_dir(cache_dir.string());
+    REQUIRE(slice_cache_enabled());
+
+    indexed_triangle_set mesh = its_make_cube(20., 20., 20.);
+    std::vector<float>   zs { 0.1f, 5.f, 10.f, 19.9f };
+    MeshSlicingParamsEx  params;
+    params.closing_radius = 0.05f;
+
+    std::vector<ExPolygons> reference = slice_mesh_ex(mesh, zs, params);
+    std::vector<ExPolygons> stored    = slice_mesh_ex_cached(mesh, zs, params);
+    const SliceCacheKey     key       = slice_cache_key(mesh, zs, params);
+
+    THEN("The entry is created and equal to the uncached slices") {
+        REQUIRE(boost::filesystem::exists(cache_dir / (key.to_string() + ".slices")));
+        REQUIRE(stored == reference);
+    }
+    THEN("The entry is loaded back") {
+        std::vector<ExPolygons> loaded;
+        REQUIRE(slice_cache_load(key, zs, loaded));
+        REQUIRE(loaded == reference);
+    }
+    THEN("A different set of slicing planes is a cache miss") {
+        std::vector<float> zs2 { 0.1f, 5.f, 10.f, 19.8f };
+        std::vector<ExPolygons> loaded;
+        REQUIRE(! (slice_cache_key(mesh, zs2, params) == key));
+        REQUIRE(! slice_cache_load(key, zs2, loaded));
+    }
+    THEN("A different transformation is a cache miss") {
+        MeshSlicingParamsEx params2 { params };
+        params2.trafo = Geometry::translation_transform(Vec3d(1., 0., 0.));
+        REQUIRE(! (slice_cache_key(mesh, zs, params2) == key));
+    }
+
+    set_slice_cache_dir({});
+    boost::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Slice cache evicts the least recently used entries", "[SliceCache]") {
+    boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    set_slice_cache_dir(cache_dir.string());
+    REQUIRE(slice_cache_enabled());
+    const size_t max_size_old = slice_cache_max_size();
+
+    // All the entries contain the same square, thus they are of the same size.
+    indexed_triangle_set            mesh = its_make_cube(20., 20., 20.);
+    MeshSlicingParamsEx             params;
+    std::vector<std::vector<float>> zs { { 1.f, 2.f }, { 3.f, 4.f }, { 5.f, 6.f }, { 7.f, 8.f } };
+    std::vector<SliceCacheKey>      keys;
+    auto entry_path = [&cache_dir](const SliceCacheKey &key) { return cache_dir / (key.to_string() + ".slices"); };
+    auto store = [&](size_t i) {
+        slice_mesh_ex_cached(mesh, zs[i], params);
+        keys.emplace_back(slice_cache_key(mesh, zs[i], params));
+        REQUIRE(boost::filesystem::exists(entry_path(keys.back())));
+    };
+
+    // Three entries used one after the other in the past.
+    const std::time_t now = std::time(nullptr);
+    for (size_t i = 0; i < 3; ++ i) {
+        store(i);
+        boost::filesystem::last_write_time(entry_path(keys[i]), now - 100 + 10 * std::time_t(i));
+    }
+    // Loading the oldest entry marks it as recently used.
+    std::vector<ExPolygons> loaded;
+    REQUIRE(slice_cache_load(keys.front(), zs.front(), loaded));
+
+    // Storing the fourth entry over the limit of two entries removes the two least recently used ones.
+    set_slice_cache_max_size(2 * size_t(boost::filesystem::file_size(entry_path(keys.front()))));
+    store(3);
+    CHECK(boost::filesystem::exists(entry_path(keys[0])));
+    CHECK(! boost::filesystem::exists(entry_path(keys[1])));
+    CHECK(! boost::filesystem::exists(entry_path(keys[2])));
+    CHECK(boost::filesystem::exists(entry_path(keys[3])));
+
+    set_slice_cache_max_size(max_size_old);
+    set_slice_cache_dir({});
+    boost::filesystem::remove_all(cache_dir);
+}
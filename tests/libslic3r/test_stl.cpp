@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "libslic3r/Model.hpp"
+#include "libslic3r/TriangleMesh.hpp"
 #include "libslic3r/Format/STL.hpp"
 
 using namespace Slic3r;
@@ -55,3 +56,49 @@ SCENARIO("Reading an STL file", "[stl]") {
 		}
 	}
 }
+
+SCENARIO("Reading a binary STL file into an indexed triangle set", "[stl]") {
+	GIVEN("binary STL file of a 20mm box") {
+		WHEN("STL file is read by load_stl_binary_indexed()") {
+			indexed_triangle_set its;
+			THEN("load should succeed and merge identical vertices") {
+				REQUIRE(Slic3r::load_stl_binary_indexed(stl_path("Geräte/20mmbox-čřšřěá.stl").c_str(), its));
+				REQUIRE(its.indices.size() == 12);
+				REQUIRE(its.vertices.size() == 8);
+				REQUIRE(its_num_open_edges(its) == 0);
+				TriangleMesh mesh(std::move(its));
+				REQUIRE(is_approx(mesh.size(), Vec3d(20, 20, 20)));
+				REQUIRE(std::abs(mesh.volume() - 8000.) < 1e-3);
+			}
+		}
+	}
+	GIVEN("binary STL file of a 20mm box and a canceled import") {
+		struct ImportCanceled {};
+		WHEN("STL file is read by load_stl_binary_indexed()") {
+			indexed_triangle_set its;
+			std::vector<int>     progress;
+			THEN("the import is aborted by the exception thrown by the cancellation callback") {
+				REQUIRE_THROWS_AS(Slic3r::load_stl_binary_indexed(stl_path("Geräte/20mmbox-čřšřěá.stl").c_str(), its,
+					[&progress](int percent) { progress.emplace_back(percent); }, []() { throw ImportCanceled(); }), ImportCanceled);
+				REQUIRE(progress.empty());
+			}
+		}
+		WHEN("STL file is read by load_stl_binary_indexed() canceled after the first progress update") {
+			indexed_triangle_set its;
+			std::vector<int>     progress;
+			THEN("the import is aborted after the first pass") {
+				REQUIRE_THROWS_AS(Slic3r::load_stl_binary_indexed(stl_path("Geräte/20mmbox-čřšřěá.stl").c_str(), its,
+					[&progress](int percent) { progress.emplace_back(percent); }, [&progress]() { if (! progress.empty()) throw ImportCanceled(); }), ImportCanceled);
+				REQUIRE(progress.size() == 1);
+			}
+		}
+	}
+	GIVEN("ASCII STL file") {
+		WHEN("STL file is read by load_stl_binary_indexed()") {
+			indexed_triangle_set its;
+			THEN("load should fail") {
+				REQUIRE(! Slic3r::load_stl_binary_indexed(stl_path("ASCII/20mmbox-LF.stl").c_str(), its));
+			}
+		}
+	}
+}